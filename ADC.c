@@ -8,6 +8,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/rom.h"
 #include "grlib/grlib.h"
@@ -32,9 +34,29 @@
 #include <string.h>
 // Necessary for ADC
 #include "driverlib/adc.h"
-// Necessary for blinking light clock cycles
-#define FIVE_PERCENT_CYCLE_ON 200000
-#define NIENTYFIVE_PERCENT_CYCLE_OFF 3800000
+// Necessary for logging samples to internal flash
+#include "flashlog.h"
+// Necessary for compressing samples sent to the computer
+#include "codec.h"
+// Necessary for sampling with ADC0 and ADC1 together
+#include "dualadc.h"
+// Necessary for the runtime configuration store
+#include "config.h"
+// Necessary for pacing samples and display updates
+#include "driverlib/timer.h"
+// Necessary for the waveform view
+#include "stripchart.h"
+
+// First byte of every compressed block sent over UART
+#define STREAM_SYNC 0xA5
+// Necessary for the timer driven status LED
+#include "led.h"
+// Necessary for filtering the samples
+#include "filter.h"
+// Necessary for direct register access in the sampling loop
+#include "hal.h"
+// Necessary for timing the HAL against driverlib
+#include "cyclebench.h"
 
 
 //*****************************************************************************
@@ -59,11 +81,38 @@ typedef struct {
 static tContext sContext;
 static tRectangle sRect;
 
+// Set while samples are being written to the flash log
+static bool g_bLogging = false;
+
+// Set when the flash log fails to write, until the log is erased
+static bool g_bLogAlarm = false;
+
+// Cleared by the T command to turn the status LED off
+static bool g_bLedEnabled = true;
+
+// Compressed samples waiting to be sent to the computer
+static uint16_t g_pui16StreamBlock[CODEC_BLOCK_SAMPLES];
+static uint32_t g_ui32StreamCount = 0;
+static uint8_t g_pui8StreamBuffer[CODEC_MAX_BLOCK_BYTES];
+
+// Configuration command line, started with '$' and ended with a new line
+static bool g_bCommandLine = false;
+static char g_pcCommandLine[32];
+static uint32_t g_ui32CommandLength = 0;
+static char g_pcCommandReply[128];
+
 // Prototypes
 char getCharacterFromComputer(void);
 void UARTSend(const uint8_t *pui8Buffer);
 void clearOLED(void);
 void printMainMenu(void);
+void configureADC0(void);
+void setAcquireMode(void);
+void setDisplayView(void);
+void applySetting(int32_t i32Item);
+bool handleCommandCharacter(char cCharacter);
+void streamSample(uint16_t ui16Sample);
+void benchmarkSampling(void);
 char displayInfoOnBoard(uint32_t pui32ADC0Value);
 
 int main(void)
@@ -104,6 +153,7 @@ int main(void)
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
 
     // Set GPIO A0 and A1 as UART pins.
     GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
@@ -112,71 +162,170 @@ int main(void)
     UARTConfigSetExpClk(UART0_BASE, ROM_SysCtlClockGet(), 115200,
                             (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
                              UART_CONFIG_PAR_NONE));
-    // Disabling the ADC to allow for configurations
-    ADCSequenceDisable(ADC0_BASE,0);
+    // Timer 0 paces the samples and timer 1 the display updates
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
 
-    // Enable sample sequence 3 with a processor signal trigger.  Sequence 3
-    // will do a single sample when the processor sends a signal to start the
-    // conversion.  Each ADC module has 4 programmable sequences, sequence 0
-    // to sequence 3.  This example is arbitrarily using sequence 3.
-    //
-    ADCSequenceConfigure(ADC0_BASE, 0, ADC_TRIGGER_PROCESSOR, 0);
+    // Load the saved settings and apply all of them
+    configInit();
+    applySetting(CONFIG_ALL);
 
-    //
-    // Configure step 0 on sequence 3.  Sample channel 0 (ADC_CTL_CH0) in
-    // single-ended mode (default) and configure the interrupt flag
-    // (ADC_CTL_IE) to be set when the sample is done.  Tell the ADC logic
-    // that this is the last conversion on sequence 3 (ADC_CTL_END).  Sequence
-    // 3 has only one programmable step.  Sequence 1 and 2 have 4 steps, and
-    // sequence 0 has 8 programmable steps.  Since we are only doing a single
-    // conversion using sequence 3 we will only configure step 0.  For more
-    // information on the ADC sequences and steps, reference the datasheet.
-    //
-    ADCSequenceStepConfigure(ADC0_BASE, 0, 0, ADC_CTL_CH7 | ADC_CTL_IE | // Do we need the ADC_CTL_IE
-                             ADC_CTL_END);
-    ADCSequenceStepConfigure(ADC0_BASE, 0, 1, ADC_CTL_CH6 | ADC_CTL_IE |
-                                 ADC_CTL_END);
-    ADCSequenceStepConfigure(ADC0_BASE, 0, 2, ADC_CTL_CH5 | ADC_CTL_IE |
-                                     ADC_CTL_END);
+    // Resume the flash log where it left off before the last reset
+    flashLogInit();
 
-    // Enabling ADC
-    ADCSequenceEnable(ADC0_BASE, 0);
-
-    // Clear the ADC interrupt flag
-    ADCIntClear(ADC0_BASE,0);
+    // Status LED patterns run from the timer 2 interrupt
+    ledInit();
+    IntMasterEnable();
 
     // Displaying message to Terminal
     printMainMenu();
     // Initializing variables
-    uint32_t pui32ADC0Value[1];
+    uint32_t pui32ADC0Value[DUALADC_MAX_SAMPLES];
+    uint32_t ui32Count;
     while(1)
     {
-        //
-        // Trigger the ADC conversion.
-        //
-        ADCProcessorTrigger(ADC0_BASE, 0);
+        // Wait for the next sample period unless running flat out
+        if (configGet(CONFIG_SAMPLE_RATE) != 0) {
+            while(!(TimerIntStatus(TIMER0_BASE, false) & TIMER_TIMA_TIMEOUT))
+            {
+            }
+            TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+        }
 
-        //
-        // Wait for conversion to be completed.
-        //
-        while(!ADCIntStatus(ADC0_BASE, 0, false))
-        {
+        if (configGet(CONFIG_ACQUIRE_MODE) == CONFIG_ACQUIRE_SINGLE) {
+            //
+            // Trigger the ADC conversion.
+            //
+            halAdc0Seq0Trigger();
+
+            //
+            // Wait for conversion to be completed.
+            //
+            while(!halAdc0Seq0IntStatus())
+            {
+            }
+
+            //
+            // Clear the ADC interrupt flag.
+            //
+            halAdc0Seq0IntClear();
+
+            //
+            // Read ADC Value.
+            //
+            ui32Count = halAdc0Seq0DataGet(pui32ADC0Value);
+        } else {
+            // Both ADC modules, merged into time order
+            ui32Count = dualAdcRead(pui32ADC0Value);
         }
 
-        //
-        // Clear the ADC interrupt flag.
-        //
-        ADCIntClear(ADC0_BASE, 0);
+        // Filter each channel of a single ADC0 sequence. The dual modes
+        // sample in bursts at the ADC rate, not at the configured rate the
+        // filters are designed for, so they pass through unfiltered.
+        if (configGet(CONFIG_ACQUIRE_MODE) == CONFIG_ACQUIRE_SINGLE) {
+            for (uint32_t index = 0; index < ui32Count; index++) {
+                pui32ADC0Value[index] = filterChainSample(index,
+                                                          pui32ADC0Value[index]);
+            }
+        }
 
-        //
-        // Read ADC Value.
-        //
-        ADCSequenceDataGet(ADC0_BASE, 0, pui32ADC0Value);
+        // Only the first channel goes on the chart: every sample when
+        // interleaved, every other one for a simultaneous pair, and the
+        // first step of each ADC0 sequence.
+        uint32_t ui32ChartStride = ui32Count;
+        if (configGet(CONFIG_ACQUIRE_MODE) == CONFIG_ACQUIRE_INTERLEAVED) {
+            ui32ChartStride = 1;
+        } else if (configGet(CONFIG_ACQUIRE_MODE) ==
+                   CONFIG_ACQUIRE_SIMULTANEOUS) {
+            ui32ChartStride = 2;
+        }
+        for (uint32_t index = 0; index < ui32Count; index += ui32ChartStride) {
+            stripChartSample(pui32ADC0Value[index]);
+        }
+
+        for (uint32_t index = 0; index < ui32Count; index++) {
+            if (g_bLogging) {
+                if (!flashLogSample(pui32ADC0Value[index])) {
+                    g_bLogAlarm = true;
+                }
+            }
+            if (configGet(CONFIG_OUTPUT_FORMAT) == CONFIG_OUTPUT_COMPRESSED) {
+                streamSample(pui32ADC0Value[index]);
+            } else if (configGet(CONFIG_OUTPUT_FORMAT) == CONFIG_OUTPUT_ASCII) {
+                char pcLine[8];
+                sprintf(pcLine, "%u\r\n", pui32ADC0Value[index]);
+                UARTSend(pcLine);
+            }
+        }
+
+        // Handle commands from the terminal
+        char cCharacter = getCharacterFromComputer();
+        if (handleCommandCharacter(cCharacter)) {
+            cCharacter = '\0';
+        }
+        switch (tolower(cCharacter)) {
+        case 'a':
+            configSet(CONFIG_OUTPUT_FORMAT,
+                      configGet(CONFIG_OUTPUT_FORMAT) == CONFIG_OUTPUT_NONE ?
+                      CONFIG_OUTPUT_COMPRESSED : CONFIG_OUTPUT_NONE);
+            applySetting(CONFIG_OUTPUT_FORMAT);
+            break;
+        case 'm':
+            configSet(CONFIG_ACQUIRE_MODE,
+                      (configGet(CONFIG_ACQUIRE_MODE) + 1) % 3);
+            applySetting(CONFIG_ACQUIRE_MODE);
+            break;
+        case 'l':
+            g_bLogging = !g_bLogging;
+            if (!g_bLogging) {
+                flashLogFlush();
+            }
+            UARTSend(g_bLogging ? "\r\nLogging on\r\n" : "\r\nLogging off\r\n");
+            break;
+        case 'd':
+            flashLogFlush();
+            flashLogDump(UART0_BASE);
+            break;
+        case 't':
+            g_bLedEnabled = !g_bLedEnabled;
+            break;
+        case 'e':
+            g_bLogAlarm = false;
+            flashLogErase();
+            UARTSend("\r\nLog erased\r\n");
+            break;
+        case 'b':
+            benchmarkSampling();
+            break;
+        }
+
+        // Show what the board is doing on the status LED
+        if (!g_bLedEnabled) {
+            ledSetPattern(LED_OFF);
+        } else if (g_bLogAlarm) {
+            ledSetPattern(LED_ALARM);
+        } else if (configGet(CONFIG_LED_DUTY) != 0) {
+            ledSetPattern(LED_CUSTOM);
+        } else if (g_bLogging ||
+                   configGet(CONFIG_OUTPUT_FORMAT) != CONFIG_OUTPUT_NONE) {
+            ledSetPattern(LED_ACQUIRING);
+        } else {
+            ledSetPattern(LED_HEARTBEAT);
+        }
 
         //
-        // Display the AIN0 (PE3) digital value on OLED.
+        // Display the AIN0 (PE3) digital value on OLED at the display rate.
         //
-        displayInfoOnBoard(pui32ADC0Value[0]);
+        if (TimerIntStatus(TIMER1_BASE, false) & TIMER_TIMA_TIMEOUT) {
+            TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+            if (configGet(CONFIG_DISPLAY_VIEW) == CONFIG_VIEW_CHART) {
+                stripChartDraw();
+            } else {
+                displayInfoOnBoard(pui32ADC0Value[ui32Count - 1]);
+            }
+        }
         //UARTprintf("AIN0 = %4d\r", pui32ADC0Value[0]);
     }
     //return 0;
@@ -185,15 +334,21 @@ int main(void)
 void printMainMenu(void) {
     UARTSend("\r\n\nT - Toggle the LED\r\n");
     UARTSend("S - Splash Screen (2s)\r\n");
-    UARTSend("A - ADC Data");
+    UARTSend("A - ADC Data (compressed stream on/off)\r\n");
+    UARTSend("M - Next mode (single/interleaved/simultaneous)\r\n");
+    UARTSend("L - Toggle flash logging\r\n");
+    UARTSend("D - Dump flash log\r\n");
+    UARTSend("E - Erase flash log\r\n");
+    UARTSend("B - Benchmark HAL against driverlib (single mode)\r\n");
+    UARTSend("$ - Settings: $list, $get <name>, $set <name> <value>, $save");
 }
 // Pulls Character from computer. If the there is a character to pull from the
 // user the function will return the character. Otherwise the function will
 // return the null character.
 char getCharacterFromComputer(void) {
-    while (UARTCharsAvail(UART0_BASE)) {
+    while (halUart0CharsAvail()) {
         int32_t localChar;
-        localChar = UARTCharGetNonBlocking(UART0_BASE);
+        localChar = halUart0CharGet();
         if (localChar != -1) {
             return localChar;
         }
@@ -207,8 +362,216 @@ void UARTSend(const uint8_t *pui8Buffer)
     for(uint32_t index = 0; index < strlen((const char *)pui8Buffer); index++)
     {
         // Write the next character to the UART.
-        UARTCharPut(UART0_BASE, pui8Buffer[index]);
+        halUart0CharPut(pui8Buffer[index]);
+    }
+}
+
+// Collects samples into blocks and sends each full block to the computer as
+// a frame: STREAM_SYNC, sample count, encoded length, then the block from
+// codecEncodeBlock().
+void streamSample(uint16_t ui16Sample) {
+    uint32_t length;
+
+    g_pui16StreamBlock[g_ui32StreamCount++] = ui16Sample;
+    if (g_ui32StreamCount < CODEC_BLOCK_SAMPLES) {
+        return;
+    }
+
+    length = codecEncodeBlock(g_pui16StreamBlock, g_ui32StreamCount,
+                              g_pui8StreamBuffer);
+    halUart0CharPut(STREAM_SYNC);
+    halUart0CharPut(g_ui32StreamCount);
+    halUart0CharPut(length);
+    for (uint32_t index = 0; index < length; index++) {
+        halUart0CharPut(g_pui8StreamBuffer[index]);
+    }
+    g_ui32StreamCount = 0;
+}
+
+// Times the single-mode read of ADC0 through the HAL and through driverlib
+// and prints the cycles per read of each. The dual modes leave ADC0 on
+// SYNCWAIT, where a plain trigger never completes, so they are refused.
+void benchmarkSampling(void) {
+    static const char *ppcPaths[] = { "HAL", "driverlib" };
+    tCycleBenchResult sResult;
+    char pcLine[64];
+
+    if (configGet(CONFIG_ACQUIRE_MODE) != CONFIG_ACQUIRE_SINGLE) {
+        UARTSend("\r\nBenchmark needs single mode\r\n");
+        return;
+    }
+
+    UARTSend("\r\ncycles per read: total, outside the wait\r\n");
+    for (uint32_t path = CYCLEBENCH_HAL; path <= CYCLEBENCH_DRIVERLIB;
+         path++) {
+        cycleBenchSampling(path, 1000, &sResult);
+        sprintf(pcLine, "%-10s %6u %6u\r\n", ppcPaths[path],
+                sResult.ui32Total, sResult.ui32Access);
+        UARTSend(pcLine);
+    }
+}
+
+// Configures sequence 0 of ADC0 for the single ADC acquisition mode.
+void configureADC0(void) {
+    // Disabling the ADC to allow for configurations
+    ADCSequenceDisable(ADC0_BASE,0);
+
+    // The dual modes trigger ADC0 with ADC_TRIGGER_WAIT, which leaves
+    // SYNCWAIT set in PSSI. Clear it, or every later trigger would wait for
+    // a global sync that never comes.
+    HWREG(ADC0_BASE + ADC_O_PSSI) &= ~ADC_PSSI_SYNCWAIT;
+
+    // Enable sample sequence 3 with a processor signal trigger.  Sequence 3
+    // will do a single sample when the processor sends a signal to start the
+    // conversion.  Each ADC module has 4 programmable sequences, sequence 0
+    // to sequence 3.  This example is arbitrarily using sequence 3.
+    //
+    ADCSequenceConfigure(ADC0_BASE, 0, ADC_TRIGGER_PROCESSOR, 0);
+
+    //
+    // Configure step 0 on sequence 3.  Sample channel 0 (ADC_CTL_CH0) in
+    // single-ended mode (default) and configure the interrupt flag
+    // (ADC_CTL_IE) to be set when the sample is done.  Tell the ADC logic
+    // that this is the last conversion on sequence 3 (ADC_CTL_END).  Sequence
+    // 3 has only one programmable step.  Sequence 1 and 2 have 4 steps, and
+    // sequence 0 has 8 programmable steps.  Since we are only doing a single
+    // conversion using sequence 3 we will only configure step 0.  For more
+    // information on the ADC sequences and steps, reference the datasheet.
+    //
+    // One step per channel in the channel mask, the last one raising the
+    // interrupt flag and ending the sequence.
+    uint32_t pui32Channels[8];
+    uint32_t ui32Steps = configChannels(pui32Channels, 8);
+    for (uint32_t step = 0; step < ui32Steps; step++) {
+        ADCSequenceStepConfigure(ADC0_BASE, 0, step, pui32Channels[step] |
+                                 (step == ui32Steps - 1 ?
+                                  ADC_CTL_IE | ADC_CTL_END : 0));
+    }
+
+    // Enabling ADC
+    ADCSequenceEnable(ADC0_BASE, 0);
+
+    // Clear the ADC interrupt flag
+    ADCIntClear(ADC0_BASE,0);
+}
+
+// Switches between ADC0 alone, ADC0 and ADC1 interleaved on the first channel
+// in the mask for twice the sample rate, and ADC0 and ADC1 sampling the first
+// two channels together.
+void setAcquireMode(void) {
+    uint32_t pui32Channels[2];
+
+    if (configChannels(pui32Channels, 2) < 2) {
+        pui32Channels[1] = pui32Channels[0];
+    }
+
+    switch (configGet(CONFIG_ACQUIRE_MODE)) {
+    case CONFIG_ACQUIRE_INTERLEAVED:
+        dualAdcInit(DUALADC_INTERLEAVED, pui32Channels[0], pui32Channels[0]);
+        break;
+    case CONFIG_ACQUIRE_SIMULTANEOUS:
+        dualAdcInit(DUALADC_SIMULTANEOUS, pui32Channels[0], pui32Channels[1]);
+        break;
+    default:
+        configureADC0();
+        break;
+    }
+}
+
+// Clears everything below the banner and starts the selected view.
+void setDisplayView(void) {
+    sRect.i16XMin = 0;
+    sRect.i16YMin = 10;
+    sRect.i16XMax = GrContextDpyWidthGet(&sContext) - 1;
+    sRect.i16YMax = GrContextDpyHeightGet(&sContext) - 1;
+    GrContextForegroundSet(&sContext, ClrBlack);
+    GrRectFill(&sContext, &sRect);
+
+    if (configGet(CONFIG_DISPLAY_VIEW) == CONFIG_VIEW_CHART) {
+        stripChartInit(&sContext);
+    }
+    GrContextForegroundSet(&sContext, ClrWhite);
+}
+
+// Applies a changed setting to the running hardware. Acquisition carries on;
+// only the peripherals behind the setting are reconfigured.
+void applySetting(int32_t i32Item) {
+    uint32_t ui32Clock = ROM_SysCtlClockGet();
+
+    if (i32Item == CONFIG_SAMPLE_RATE || i32Item == CONFIG_ALL) {
+        TimerDisable(TIMER0_BASE, TIMER_A);
+        if (configGet(CONFIG_SAMPLE_RATE) != 0) {
+            TimerLoadSet(TIMER0_BASE, TIMER_A,
+                         ui32Clock / configGet(CONFIG_SAMPLE_RATE) - 1);
+            TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+            TimerEnable(TIMER0_BASE, TIMER_A);
+        }
+    }
+    if (i32Item == CONFIG_CHANNEL_MASK || i32Item == CONFIG_ACQUIRE_MODE ||
+        i32Item == CONFIG_ALL) {
+        setAcquireMode();
+    }
+    if (i32Item == CONFIG_AVERAGING || i32Item == CONFIG_ALL) {
+        ADCHardwareOversampleConfigure(ADC0_BASE, configGet(CONFIG_AVERAGING));
+        ADCHardwareOversampleConfigure(ADC1_BASE, configGet(CONFIG_AVERAGING));
+    }
+    if (i32Item == CONFIG_OUTPUT_FORMAT || i32Item == CONFIG_ALL) {
+        // Start the compressed stream on a block boundary
+        g_ui32StreamCount = 0;
+    }
+    if (i32Item == CONFIG_FILTER || i32Item == CONFIG_CUTOFF ||
+        i32Item == CONFIG_SAMPLE_RATE || i32Item == CONFIG_CHANNEL_MASK ||
+        i32Item == CONFIG_ALL) {
+        // The filters need a known sample rate, so none run at rate 0
+        filterChainConfigure(configGet(CONFIG_FILTER),
+                             (float)configGet(CONFIG_SAMPLE_RATE),
+                             (float)configGet(CONFIG_CUTOFF));
+    }
+    if (i32Item == CONFIG_DISPLAY_VIEW || i32Item == CONFIG_ALL) {
+        setDisplayView();
+    }
+    if (i32Item == CONFIG_DISPLAY_RATE || i32Item == CONFIG_ALL) {
+        TimerLoadSet(TIMER1_BASE, TIMER_A,
+                     ui32Clock / configGet(CONFIG_DISPLAY_RATE) - 1);
+        TimerEnable(TIMER1_BASE, TIMER_A);
+    }
+    if (i32Item == CONFIG_LED_DUTY || i32Item == CONFIG_LED_PERIOD ||
+        i32Item == CONFIG_ALL) {
+        // The ranges in config.c always fit the LED timer
+        ledSetDuty(configGet(CONFIG_LED_PERIOD) * 1000,
+                   configGet(CONFIG_LED_DUTY));
+    }
+}
+
+// Collects a '$' configuration command one character per loop pass, so
+// sampling never waits on the terminal. Returns true if the character was
+// taken by the command line.
+bool handleCommandCharacter(char cCharacter) {
+    if (!g_bCommandLine) {
+        if (cCharacter != '$') {
+            return false;
+        }
+        g_bCommandLine = true;
+        g_ui32CommandLength = 0;
+        return true;
+    }
+    if (cCharacter == '\0') {
+        return false;
+    }
+    if (cCharacter == '\r' || cCharacter == '\n') {
+        g_pcCommandLine[g_ui32CommandLength] = '\0';
+        g_bCommandLine = false;
+        applySetting(configCommand(g_pcCommandLine, g_pcCommandReply,
+                                   sizeof(g_pcCommandReply)));
+        UARTSend("\r\n");
+        UARTSend(g_pcCommandReply);
+        UARTSend("\r\n");
+        return true;
+    }
+    if (g_ui32CommandLength < sizeof(g_pcCommandLine) - 1) {
+        g_pcCommandLine[g_ui32CommandLength++] = tolower(cCharacter);
     }
+    return true;
 }
 
 void clearOLED(void) {
@@ -0,0 +1,175 @@
+/* Purpose of the following file is to compress blocks of 12-bit ADC samples
+ * without losing any information.
+ *
+ * Each sample after the first is replaced by the difference to its
+ * predecessor. The differences are zigzag mapped (0, -1, 1, -2, ... becomes
+ * 0, 1, 2, 3, ...) so small changes of either sign give small numbers, and
+ * then written with whichever of these is shortest for the block:
+ *
+ *   Rice coding with parameter k: the value shifted right by k in unary
+ *   (ones ended by a zero) followed by the low k bits. Best for slowly
+ *   changing signals.
+ *
+ *   Plain bit-packing with just enough bits for the largest value. Caps the
+ *   size of noisy blocks where Rice codes would grow long.
+ *
+ * Block layout (bits are filled least significant first):
+ *   16 bits  first sample
+ *    8 bits  mode: high nibble 0 = Rice, 1 = bit-packed; low nibble k or width
+ *   ...      (count - 1) coded deltas
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "codec.h"
+
+#define CODEC_MODE_RICE         0x00
+#define CODEC_MODE_PACKED       0x10
+#define CODEC_MAX_WIDTH         13
+
+static uint32_t zigzag(int32_t i32Delta) {
+    return ((uint32_t)i32Delta << 1) ^ (uint32_t)(i32Delta >> 31);
+}
+
+static int32_t unzigzag(uint32_t ui32Value) {
+    return (int32_t)(ui32Value >> 1) ^ -(int32_t)(ui32Value & 1);
+}
+
+static void putBits(uint8_t *pui8Out, uint32_t *pui32BitPos, uint32_t ui32Value,
+                    uint32_t ui32Bits) {
+    for (uint32_t bit = 0; bit < ui32Bits; bit++) {
+        if (ui32Value & (1 << bit)) {
+            pui8Out[*pui32BitPos >> 3] |= 1 << (*pui32BitPos & 7);
+        }
+        (*pui32BitPos)++;
+    }
+}
+
+// Returns false instead of reading past the end of the input.
+static bool getBits(const uint8_t *pui8In, uint32_t ui32Bytes,
+                    uint32_t *pui32BitPos, uint32_t ui32Bits,
+                    uint32_t *pui32Value) {
+    *pui32Value = 0;
+    if (*pui32BitPos + ui32Bits > ui32Bytes * 8) {
+        return false;
+    }
+    for (uint32_t bit = 0; bit < ui32Bits; bit++) {
+        if (pui8In[*pui32BitPos >> 3] & (1 << (*pui32BitPos & 7))) {
+            *pui32Value |= 1 << bit;
+        }
+        (*pui32BitPos)++;
+    }
+    return true;
+}
+
+// Encodes ui32Count samples (1 to CODEC_BLOCK_SAMPLES) into pui8Out, which
+// must hold CODEC_MAX_BLOCK_BYTES. Returns the encoded length in bytes.
+uint32_t codecEncodeBlock(const uint16_t *pui16Samples, uint32_t ui32Count,
+                          uint8_t *pui8Out) {
+    uint32_t pui32Zigzag[CODEC_BLOCK_SAMPLES];
+    uint32_t pui32RiceBits[CODEC_MAX_WIDTH];
+    uint32_t largest = 0;
+    uint32_t width = 0;
+    uint32_t bestBits, mode, bitPos = 0;
+
+    for (uint32_t k = 0; k < CODEC_MAX_WIDTH; k++) {
+        pui32RiceBits[k] = 0;
+    }
+
+    // Work out the size of every candidate coding in a single pass.
+    for (uint32_t i = 1; i < ui32Count; i++) {
+        uint32_t value = zigzag((int32_t)(pui16Samples[i] & 0x0FFF) -
+                                (int32_t)(pui16Samples[i - 1] & 0x0FFF));
+        pui32Zigzag[i] = value;
+        largest |= value;
+        for (uint32_t k = 0; k < CODEC_MAX_WIDTH; k++) {
+            pui32RiceBits[k] += (value >> k) + 1 + k;
+        }
+    }
+    while (width < CODEC_MAX_WIDTH && (largest >> width) != 0) {
+        width++;
+    }
+
+    mode = CODEC_MODE_PACKED | width;
+    bestBits = width * (ui32Count - 1);
+    for (uint32_t k = 0; k < CODEC_MAX_WIDTH; k++) {
+        if (pui32RiceBits[k] < bestBits) {
+            bestBits = pui32RiceBits[k];
+            mode = CODEC_MODE_RICE | k;
+        }
+    }
+
+    for (uint32_t i = 0; i < 3 + (bestBits + 7) / 8; i++) {
+        pui8Out[i] = 0;
+    }
+    putBits(pui8Out, &bitPos, pui16Samples[0] & 0x0FFF, 16);
+    putBits(pui8Out, &bitPos, mode, 8);
+
+    for (uint32_t i = 1; i < ui32Count; i++) {
+        if ((mode & 0xF0) == CODEC_MODE_PACKED) {
+            putBits(pui8Out, &bitPos, pui32Zigzag[i], width);
+        } else {
+            uint32_t k = mode & 0x0F;
+            // An outlier can have a quotient wider than a word, so the unary
+            // part is written one bit at a time.
+            for (uint32_t q = pui32Zigzag[i] >> k; q > 0; q--) {
+                putBits(pui8Out, &bitPos, 1, 1);
+            }
+            putBits(pui8Out, &bitPos, 0, 1);
+            putBits(pui8Out, &bitPos, pui32Zigzag[i], k);
+        }
+    }
+    return (bitPos + 7) >> 3;
+}
+
+// Decodes a block produced by codecEncodeBlock(). The sample count is not
+// stored in the block, so the caller passes it from its own framing. Returns
+// false if the block is malformed or shorter than expected.
+bool codecDecodeBlock(const uint8_t *pui8In, uint32_t ui32Bytes,
+                      uint16_t *pui16Samples, uint32_t ui32Count) {
+    uint32_t bitPos = 0;
+    uint32_t value, mode, param;
+
+    if (ui32Count == 0 || ui32Count > CODEC_BLOCK_SAMPLES ||
+        !getBits(pui8In, ui32Bytes, &bitPos, 16, &value) || value > 0x0FFF ||
+        !getBits(pui8In, ui32Bytes, &bitPos, 8, &mode)) {
+        return false;
+    }
+    param = mode & 0x0F;
+    if (param > CODEC_MAX_WIDTH ||
+        ((mode & 0xF0) != CODEC_MODE_PACKED && (mode & 0xF0) != CODEC_MODE_RICE)) {
+        return false;
+    }
+    pui16Samples[0] = value;
+
+    for (uint32_t i = 1; i < ui32Count; i++) {
+        uint32_t zig;
+
+        if ((mode & 0xF0) == CODEC_MODE_PACKED) {
+            if (!getBits(pui8In, ui32Bytes, &bitPos, param, &zig)) {
+                return false;
+            }
+        } else {
+            uint32_t quotient = 0;
+            uint32_t bit, remainder;
+            do {
+                if (!getBits(pui8In, ui32Bytes, &bitPos, 1, &bit)) {
+                    return false;
+                }
+                quotient += bit;
+            } while (bit);
+            if (!getBits(pui8In, ui32Bytes, &bitPos, param, &remainder)) {
+                return false;
+            }
+            zig = (quotient << param) | remainder;
+        }
+
+        value = (uint32_t)((int32_t)pui16Samples[i - 1] + unzigzag(zig));
+        if (value > 0x0FFF) {
+            return false;
+        }
+        pui16Samples[i] = value;
+    }
+    return true;
+}
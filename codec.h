@@ -0,0 +1,35 @@
+/* Purpose of the following file is to declare the lossless block codec used
+ * to shrink 12-bit ADC samples before they go out over the UART or into the
+ * flash log. The codec has no hardware dependencies, so the same file builds
+ * into host tools that decode the stream.
+ *
+ */
+
+#ifndef __CODEC_H__
+#define __CODEC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Number of samples per encoded block.
+#define CODEC_BLOCK_SAMPLES     64
+
+// Worst case size of an encoded block: first sample, mode byte and every
+// delta bit-packed at the full 13-bit zigzag width.
+#define CODEC_MAX_BLOCK_BYTES   (3 + ((CODEC_BLOCK_SAMPLES - 1) * 13 + 7) / 8)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern uint32_t codecEncodeBlock(const uint16_t *pui16Samples,
+                                 uint32_t ui32Count, uint8_t *pui8Out);
+extern bool codecDecodeBlock(const uint8_t *pui8In, uint32_t ui32Bytes,
+                             uint16_t *pui16Samples, uint32_t ui32Count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CODEC_H__
@@ -0,0 +1,226 @@
+/* Purpose of the following file is to keep every acquisition parameter in one
+ * registry instead of hard-coding it in ADC.c.
+ *
+ * Each setting has a name, a valid range and a default. The values are saved
+ * to EEPROM as one record (magic word, values, checksum) and read back at
+ * start-up; a missing or damaged record falls back to the defaults.
+ *
+ * Terminal commands, one per line:
+ *   get <name>          reply <name>=<value>
+ *   set <name> <value>  reply <name>=<value>, or ERR if out of range
+ *   list                reply every <name>=<value>
+ *   save                write the current values to EEPROM
+ *   defaults            restore the defaults (not saved until "save")
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driverlib/adc.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+#include "config.h"
+#include "filter.h"
+
+#define CONFIG_EEPROM_ADDRESS   0
+#define CONFIG_MAGIC            0x34474643  // "CFG4"
+
+// Setting must be a power of two.
+#define CONFIG_FLAG_POW2        0x01
+// Setting is a bit mask with at most 8 bits set, one per step of ADC0
+// sequence 0.
+#define CONFIG_FLAG_MAX8        0x02
+
+typedef struct {
+    const char *pcName;
+    uint32_t ui32Min;
+    uint32_t ui32Max;
+    uint32_t ui32Default;
+    uint32_t ui32Flags;
+} tConfigEntry;
+
+// Indexed by tConfigItem.
+static const tConfigEntry g_psConfigEntries[CONFIG_NUM_ITEMS] = {
+    { "rate",     0, 100000,    0,                      0 },
+    { "channels", 1, 0xFFFFFF,  1 << 7,                 CONFIG_FLAG_MAX8 },
+    { "avg",      1, 64,        1,                      CONFIG_FLAG_POW2 },
+    { "format",   0, 2,         CONFIG_OUTPUT_NONE,     0 },
+    { "display",  1, 60,        10,                     0 },
+    { "mode",     0, 2,         CONFIG_ACQUIRE_SINGLE,  0 },
+    { "view",     0, 1,         CONFIG_VIEW_NUMBER,     0 },
+    { "filter",   0, 4,         FILTER_NONE,            0 },
+    { "cutoff",   1, 50000,     100,                    0 },
+    { "ledduty",  0, 100,       0,                      0 },
+    { "ledperiod", 10, 10000,   1000,                   0 },
+};
+
+// Stored record: magic, one word per setting, checksum.
+static uint32_t g_pui32Record[CONFIG_NUM_ITEMS + 2];
+static uint32_t *g_pui32Values = &g_pui32Record[1];
+
+static uint32_t checksum(void) {
+    uint32_t sum = CONFIG_MAGIC;
+    for (uint32_t item = 0; item < CONFIG_NUM_ITEMS; item++) {
+        sum = (sum << 1 | sum >> 31) ^ g_pui32Values[item];
+    }
+    return sum;
+}
+
+static bool isValid(tConfigItem eItem, uint32_t ui32Value) {
+    const tConfigEntry *psEntry = &g_psConfigEntries[eItem];
+
+    if (ui32Value < psEntry->ui32Min || ui32Value > psEntry->ui32Max) {
+        return false;
+    }
+    if ((psEntry->ui32Flags & CONFIG_FLAG_POW2) &&
+        (ui32Value & (ui32Value - 1)) != 0) {
+        return false;
+    }
+    if (psEntry->ui32Flags & CONFIG_FLAG_MAX8) {
+        uint32_t bits = 0;
+        for (uint32_t mask = ui32Value; mask; mask &= mask - 1) {
+            bits++;
+        }
+        if (bits > 8) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int32_t findItem(const char *pcName) {
+    for (uint32_t item = 0; item < CONFIG_NUM_ITEMS; item++) {
+        if (strcmp(pcName, g_psConfigEntries[item].pcName) == 0) {
+            return item;
+        }
+    }
+    return CONFIG_NONE;
+}
+
+void configDefaults(void) {
+    for (uint32_t item = 0; item < CONFIG_NUM_ITEMS; item++) {
+        g_pui32Values[item] = g_psConfigEntries[item].ui32Default;
+    }
+}
+
+// Loads the saved settings, or the defaults if EEPROM holds no valid record.
+void configInit(void) {
+    bool valid;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0))
+    {
+    }
+
+    if (EEPROMInit() != EEPROM_INIT_OK) {
+        configDefaults();
+        return;
+    }
+
+    EEPROMRead(g_pui32Record, CONFIG_EEPROM_ADDRESS, sizeof(g_pui32Record));
+    valid = g_pui32Record[0] == CONFIG_MAGIC &&
+            g_pui32Record[CONFIG_NUM_ITEMS + 1] == checksum();
+    for (uint32_t item = 0; valid && item < CONFIG_NUM_ITEMS; item++) {
+        valid = isValid((tConfigItem)item, g_pui32Values[item]);
+    }
+    if (!valid) {
+        configDefaults();
+    }
+}
+
+uint32_t configGet(tConfigItem eItem) {
+    return g_pui32Values[eItem];
+}
+
+// Changes a setting in RAM. Returns false and keeps the old value if the new
+// one is out of range.
+bool configSet(tConfigItem eItem, uint32_t ui32Value) {
+    if (!isValid(eItem, ui32Value)) {
+        return false;
+    }
+    g_pui32Values[eItem] = ui32Value;
+    return true;
+}
+
+// Lists the channels set in CONFIG_CHANNEL_MASK, lowest first, as the
+// ADC_CTL_CHx values that select them. Returns how many were found.
+uint32_t configChannels(uint32_t *pui32Channels, uint32_t ui32Max) {
+    uint32_t mask = g_pui32Values[CONFIG_CHANNEL_MASK];
+    uint32_t count = 0;
+
+    for (uint32_t channel = 0; channel < 24 && count < ui32Max; channel++) {
+        if (mask & (1 << channel)) {
+            // ADC_CTL_CH0..15 are the channel number, but AIN16..23 are
+            // selected by the extended mux bits: ADC_CTL_CH16 is 0x100, and
+            // 0x10 would be ADC_CTL_D, a differential pair.
+            pui32Channels[count++] = channel < 16 ? channel :
+                                     ADC_CTL_CH16 | (channel - 16);
+        }
+    }
+    return count;
+}
+
+bool configSave(void) {
+    g_pui32Record[0] = CONFIG_MAGIC;
+    g_pui32Record[CONFIG_NUM_ITEMS + 1] = checksum();
+    return EEPROMProgram(g_pui32Record, CONFIG_EEPROM_ADDRESS,
+                         sizeof(g_pui32Record)) == 0;
+}
+
+// Runs one terminal command and writes the reply (without line ending) to
+// pcReply. Returns the item that changed, CONFIG_ALL if they all did, or
+// CONFIG_NONE, so the caller knows what to apply.
+int32_t configCommand(const char *pcLine, char *pcReply,
+                      uint32_t ui32ReplySize) {
+    char pcVerb[10], pcName[10];
+    uint32_t value;
+    int32_t item;
+    int fields;
+
+    pcVerb[0] = '\0';
+    pcName[0] = '\0';
+    fields = sscanf(pcLine, "%9s %9s %u", pcVerb, pcName, &value);
+
+    if (strcmp(pcVerb, "list") == 0) {
+        uint32_t used = 0;
+        pcReply[0] = '\0';
+        for (item = 0; item < CONFIG_NUM_ITEMS && used < ui32ReplySize; item++) {
+            used += snprintf(pcReply + used, ui32ReplySize - used, "%s%s=%u",
+                             item ? " " : "", g_psConfigEntries[item].pcName,
+                             g_pui32Values[item]);
+        }
+        return CONFIG_NONE;
+    }
+    if (strcmp(pcVerb, "save") == 0) {
+        snprintf(pcReply, ui32ReplySize, configSave() ? "OK" : "ERR eeprom");
+        return CONFIG_NONE;
+    }
+    if (strcmp(pcVerb, "defaults") == 0) {
+        configDefaults();
+        snprintf(pcReply, ui32ReplySize, "OK");
+        return CONFIG_ALL;
+    }
+
+    item = findItem(pcName);
+    if (item == CONFIG_NONE) {
+        snprintf(pcReply, ui32ReplySize, "ERR name");
+        return CONFIG_NONE;
+    }
+    if (strcmp(pcVerb, "get") == 0 && fields == 2) {
+        snprintf(pcReply, ui32ReplySize, "%s=%u", pcName, g_pui32Values[item]);
+        return CONFIG_NONE;
+    }
+    if (strcmp(pcVerb, "set") == 0 && fields == 3) {
+        if (!configSet((tConfigItem)item, value)) {
+            snprintf(pcReply, ui32ReplySize, "ERR range");
+            return CONFIG_NONE;
+        }
+        snprintf(pcReply, ui32ReplySize, "%s=%u", pcName, g_pui32Values[item]);
+        return item;
+    }
+    snprintf(pcReply, ui32ReplySize, "ERR command");
+    return CONFIG_NONE;
+}
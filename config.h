@@ -0,0 +1,66 @@
+/* Purpose of the following file is to declare the runtime configuration
+ * store. Acquisition parameters live in a typed registry that is persisted
+ * to the internal EEPROM and can be read and changed over UART while the
+ * board keeps sampling.
+ *
+ */
+
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    CONFIG_SAMPLE_RATE,     // Samples per second, 0 = as fast as possible
+    CONFIG_CHANNEL_MASK,    // Bit n samples AINn, up to 8 channels
+    CONFIG_AVERAGING,       // Hardware oversampling factor, 1 = off
+    CONFIG_OUTPUT_FORMAT,   // CONFIG_OUTPUT_* value
+    CONFIG_DISPLAY_RATE,    // OLED updates per second
+    CONFIG_ACQUIRE_MODE,    // CONFIG_ACQUIRE_* value
+    CONFIG_DISPLAY_VIEW,    // CONFIG_VIEW_* value
+    CONFIG_FILTER,          // FILTER_* value from filter.h
+    CONFIG_CUTOFF,          // Filter corner frequency in Hz
+    CONFIG_LED_DUTY,        // Status LED duty cycle in %, 0 = status patterns
+    CONFIG_LED_PERIOD,      // Status LED blink period in ms
+    CONFIG_NUM_ITEMS
+} tConfigItem;
+
+// Values of CONFIG_OUTPUT_FORMAT
+#define CONFIG_OUTPUT_NONE          0
+#define CONFIG_OUTPUT_COMPRESSED    1
+#define CONFIG_OUTPUT_ASCII         2
+
+// Values of CONFIG_ACQUIRE_MODE
+#define CONFIG_ACQUIRE_SINGLE       0
+#define CONFIG_ACQUIRE_INTERLEAVED  1
+#define CONFIG_ACQUIRE_SIMULTANEOUS 2
+
+// Values of CONFIG_DISPLAY_VIEW
+#define CONFIG_VIEW_NUMBER          0
+#define CONFIG_VIEW_CHART           1
+
+// Returned by configCommand() when nothing changed, or when every setting
+// changed at once.
+#define CONFIG_NONE                 -1
+#define CONFIG_ALL                  CONFIG_NUM_ITEMS
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void configInit(void);
+extern uint32_t configGet(tConfigItem eItem);
+extern bool configSet(tConfigItem eItem, uint32_t ui32Value);
+extern void configDefaults(void);
+extern uint32_t configChannels(uint32_t *pui32Channels, uint32_t ui32Max);
+extern bool configSave(void);
+extern int32_t configCommand(const char *pcLine, char *pcReply,
+                             uint32_t ui32ReplySize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CONFIG_H__
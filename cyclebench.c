@@ -0,0 +1,60 @@
+/* Purpose of the following file is to time the single-mode sampling loop,
+ * trigger, wait, clear and read of ADC0 sequence 0, once through the HAL and
+ * once through driverlib, with the Cortex-M4 cycle counter.
+ *
+ * ADC0 must already be set up by configureADC0() and not be waiting on
+ * SYNCWAIT, and ui32Iterations must not be zero. Each half of the iteration
+ * is bracketed by cycle counter reads; their own cost is the same for both
+ * paths, so the difference between the two results is the cost of the calls
+ * themselves.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "hal.h"
+#include "cyclebench.h"
+
+static uint32_t g_pui32Samples[HAL_ADC_FIFO_DEPTH];
+
+void cycleBenchSampling(uint32_t ui32Path, uint32_t ui32Iterations,
+                        tCycleBenchResult *psResult) {
+    uint32_t start, access = 0;
+
+    halCycleCounterEnable();
+    start = halCycleCount();
+
+    for (uint32_t i = 0; i < ui32Iterations; i++) {
+        uint32_t t0, t1, t2, t3;
+
+        if (ui32Path == CYCLEBENCH_HAL) {
+            t0 = halCycleCount();
+            halAdc0Seq0Trigger();
+            t1 = halCycleCount();
+            while(!halAdc0Seq0IntStatus())
+            {
+            }
+            t2 = halCycleCount();
+            halAdc0Seq0IntClear();
+            halAdc0Seq0DataGet(g_pui32Samples);
+            t3 = halCycleCount();
+        } else {
+            t0 = halCycleCount();
+            ADCProcessorTrigger(ADC0_BASE, 0);
+            t1 = halCycleCount();
+            while(!ADCIntStatus(ADC0_BASE, 0, false))
+            {
+            }
+            t2 = halCycleCount();
+            ADCIntClear(ADC0_BASE, 0);
+            ADCSequenceDataGet(ADC0_BASE, 0, g_pui32Samples);
+            t3 = halCycleCount();
+        }
+        access += (t1 - t0) + (t3 - t2);
+    }
+
+    psResult->ui32Total = (halCycleCount() - start) / ui32Iterations;
+    psResult->ui32Access = access / ui32Iterations;
+}
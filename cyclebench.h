@@ -0,0 +1,37 @@
+/* Purpose of the following file is to declare the sampling benchmark that
+ * compares the register-level HAL in hal.h with the driverlib calls it
+ * replaces, in CPU cycles per ADC0 sequence read.
+ *
+ */
+
+#ifndef __CYCLEBENCH_H__
+#define __CYCLEBENCH_H__
+
+#include <stdint.h>
+
+// Ways of driving one ADC0 sequence 0 read.
+#define CYCLEBENCH_HAL          0
+#define CYCLEBENCH_DRIVERLIB    1
+
+typedef struct {
+    // Cycles per iteration, conversion time included.
+    uint32_t ui32Total;
+
+    // Cycles per iteration spent triggering, clearing and reading, i.e.
+    // everything but the wait for the conversion to finish.
+    uint32_t ui32Access;
+} tCycleBenchResult;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void cycleBenchSampling(uint32_t ui32Path, uint32_t ui32Iterations,
+                               tCycleBenchResult *psResult);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CYCLEBENCH_H__
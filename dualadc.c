@@ -0,0 +1,101 @@
+/* Purpose of the following file is to sample with both ADC modules of the
+ * TM4C123 at once. Sequence 0 of ADC0 and ADC1 is filled with the requested
+ * channel, both sequences are started by a single synchronized processor
+ * trigger, and the two FIFOs are merged so the caller sees samples in the
+ * order they were taken.
+ *
+ * In interleaved mode ADC1 is phase delayed by 180 degrees, so its step i is
+ * taken halfway between steps i and i + 1 of ADC0. In simultaneous mode both
+ * modules sample step i at the same instant and the ADC0 sample comes first.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/sysctl.h"
+#include "hal.h"
+#include "dualadc.h"
+
+static uint32_t g_pui32ADC0Values[DUALADC_STEPS];
+static uint32_t g_pui32ADC1Values[DUALADC_STEPS];
+
+// Fills sequence 0 of one module with the same channel on every step.
+static void configureSequence(uint32_t ui32Base, uint32_t ui32Channel,
+                              uint32_t ui32Phase) {
+    ADCSequenceDisable(ui32Base, 0);
+    ADCSequenceConfigure(ui32Base, 0, ADC_TRIGGER_PROCESSOR, 0);
+    ADCPhaseDelaySet(ui32Base, ui32Phase);
+
+    for (uint32_t step = 0; step < DUALADC_STEPS - 1; step++) {
+        ADCSequenceStepConfigure(ui32Base, 0, step, ui32Channel);
+    }
+    ADCSequenceStepConfigure(ui32Base, 0, DUALADC_STEPS - 1,
+                             ui32Channel | ADC_CTL_IE | ADC_CTL_END);
+
+    ADCSequenceEnable(ui32Base, 0);
+    ADCIntClear(ui32Base, 0);
+}
+
+// Sets up both modules. ui32Channel1 is ignored in interleaved mode, where
+// both modules sample ui32Channel0. Channels are ADC_CTL_CHx values.
+void dualAdcInit(tDualAdcMode eMode, uint32_t ui32Channel0,
+                 uint32_t ui32Channel1) {
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC1))
+    {
+    }
+
+    if (eMode == DUALADC_INTERLEAVED) {
+        configureSequence(ADC0_BASE, ui32Channel0, ADC_PHASE_0);
+        configureSequence(ADC1_BASE, ui32Channel0, ADC_PHASE_180);
+    } else {
+        configureSequence(ADC0_BASE, ui32Channel0, ADC_PHASE_0);
+        configureSequence(ADC1_BASE, ui32Channel1, ADC_PHASE_0);
+    }
+}
+
+// Interleaves the two FIFOs into time order. Both modules start on the same
+// trigger, so sample i of ADC0 is always taken no later than sample i of
+// ADC1. A module that returned fewer samples just ends its part early.
+uint32_t dualAdcMerge(const uint32_t *pui32ADC0, uint32_t ui32Count0,
+                      const uint32_t *pui32ADC1, uint32_t ui32Count1,
+                      uint32_t *pui32Merged) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < ui32Count0 || i < ui32Count1; i++) {
+        if (i < ui32Count0) {
+            pui32Merged[count++] = pui32ADC0[i];
+        }
+        if (i < ui32Count1) {
+            pui32Merged[count++] = pui32ADC1[i];
+        }
+    }
+    return count;
+}
+
+// Starts both sequences together, waits for both to finish and writes the
+// merged samples to pui32Samples, which must hold DUALADC_MAX_SAMPLES.
+// Returns the number of samples written.
+uint32_t dualAdcRead(uint32_t *pui32Samples) {
+    uint32_t count0, count1;
+
+    // ADC0 arms and waits; the trigger on ADC1 signals both modules through
+    // the global sync so they start on the same ADC clock.
+    halAdc0Seq0TriggerWait();
+    halAdc1Seq0TriggerSignal();
+
+    while(!halAdc0Seq0IntStatus() || !halAdc1Seq0IntStatus())
+    {
+    }
+    halAdc0Seq0IntClear();
+    halAdc1Seq0IntClear();
+
+    count0 = halAdc0Seq0DataGet(g_pui32ADC0Values);
+    count1 = halAdc1Seq0DataGet(g_pui32ADC1Values);
+
+    return dualAdcMerge(g_pui32ADC0Values, count0, g_pui32ADC1Values, count1,
+                        pui32Samples);
+}
@@ -0,0 +1,43 @@
+/* Purpose of the following file is to declare the dual ADC acquisition mode,
+ * which runs ADC0 and ADC1 together and merges both into one time-ordered
+ * stream of samples.
+ *
+ */
+
+#ifndef __DUALADC_H__
+#define __DUALADC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Steps used on sample sequence 0 of each module (sequence 0 holds up to 8).
+#define DUALADC_STEPS           8
+
+// Samples returned by one call to dualAdcRead().
+#define DUALADC_MAX_SAMPLES     (2 * DUALADC_STEPS)
+
+typedef enum {
+    // Both modules sample the same channel, ADC1 half a conversion (sample
+    // period) behind ADC0, for twice the sample rate on that channel.
+    DUALADC_INTERLEAVED,
+    // Each module samples its own channel at the same instant.
+    DUALADC_SIMULTANEOUS
+} tDualAdcMode;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void dualAdcInit(tDualAdcMode eMode, uint32_t ui32Channel0,
+                        uint32_t ui32Channel1);
+extern uint32_t dualAdcRead(uint32_t *pui32Samples);
+extern uint32_t dualAdcMerge(const uint32_t *pui32ADC0, uint32_t ui32Count0,
+                             const uint32_t *pui32ADC1, uint32_t ui32Count1,
+                             uint32_t *pui32Merged);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DUALADC_H__
@@ -0,0 +1,233 @@
+/* Purpose of the following file is to remove noise from the sample stream
+ * with cascaded biquads and a short FIR filter, computed in single precision
+ * on the M4 FPU.
+ *
+ * Biquads are designed with the usual bilinear transform formulas (Robert
+ * Bristow-Johnson's audio EQ cookbook), the FIR as a Hamming windowed sinc.
+ * filterProcess() takes a block so the coefficients stay in registers across
+ * samples when a tool has a whole record. The firmware chain gets one sample
+ * per channel from each ADC sequence and runs it straight away, so there it
+ * is called one sample at a time.
+ *
+ * A high-pass removes the DC level the ADC input sits on, so its output is
+ * centred on mid-scale; otherwise the negative half of the signal would be
+ * clipped to 0. The other types pass DC and keep the input's level.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "filter.h"
+
+#define FILTER_PI               3.14159265f
+#define FILTER_ADC_MAX          4095
+#define FILTER_MID_SCALE        2048
+
+// Q of the two sections of a 4th order Butterworth.
+static const float g_pfButterworthQ[2] = { 0.5411961f, 1.3065630f };
+
+static tFilterDesign g_sChainDesign;
+static float g_fChainOffset;
+static tFilterState g_psChainStates[FILTER_MAX_CHANNELS];
+static bool g_pbChainPrimed[FILTER_MAX_CHANNELS];
+
+static void designBiquad(tBiquad *psBiquad, uint32_t ui32Type, float fOmega,
+                         float fQ) {
+    float cosine = cosf(fOmega);
+    float alpha = sinf(fOmega) / (2.0f * fQ);
+    float a0 = 1.0f + alpha;
+
+    switch (ui32Type) {
+    case FILTER_HIGHPASS:
+        psBiquad->fB0 = (1.0f + cosine) / 2.0f;
+        psBiquad->fB1 = -(1.0f + cosine);
+        psBiquad->fB2 = (1.0f + cosine) / 2.0f;
+        break;
+    case FILTER_NOTCH:
+        psBiquad->fB0 = 1.0f;
+        psBiquad->fB1 = -2.0f * cosine;
+        psBiquad->fB2 = 1.0f;
+        break;
+    default:
+        psBiquad->fB0 = (1.0f - cosine) / 2.0f;
+        psBiquad->fB1 = 1.0f - cosine;
+        psBiquad->fB2 = (1.0f - cosine) / 2.0f;
+        break;
+    }
+    psBiquad->fA1 = -2.0f * cosine;
+    psBiquad->fA2 = 1.0f - alpha;
+
+    psBiquad->fB0 /= a0;
+    psBiquad->fB1 /= a0;
+    psBiquad->fB2 /= a0;
+    psBiquad->fA1 /= a0;
+    psBiquad->fA2 /= a0;
+}
+
+// Designs one of the FILTER_* types. fCutoff is the corner (or notch)
+// frequency in Hz and is kept below 0.45 of the sample rate.
+void filterDesign(tFilterDesign *psDesign, uint32_t ui32Type,
+                  float fSampleRate, float fCutoff) {
+    float omega;
+
+    psDesign->ui32NumBiquads = 0;
+    psDesign->ui32NumTaps = 0;
+
+    if (fCutoff > 0.45f * fSampleRate) {
+        fCutoff = 0.45f * fSampleRate;
+    }
+    omega = 2.0f * FILTER_PI * fCutoff / fSampleRate;
+
+    switch (ui32Type) {
+    case FILTER_LOWPASS:
+    case FILTER_HIGHPASS:
+        for (uint32_t section = 0; section < 2; section++) {
+            designBiquad(&psDesign->psBiquads[section], ui32Type, omega,
+                         g_pfButterworthQ[section]);
+        }
+        psDesign->ui32NumBiquads = 2;
+        break;
+    case FILTER_NOTCH:
+        designBiquad(&psDesign->psBiquads[0], ui32Type, omega, 5.0f);
+        psDesign->ui32NumBiquads = 1;
+        break;
+    case FILTER_FIR_LOWPASS: {
+        const uint32_t taps = 15;
+        float sum = 0.0f;
+
+        for (uint32_t tap = 0; tap < taps; tap++) {
+            float n = (float)tap - (taps - 1) / 2.0f;
+            float sinc = n == 0.0f ? omega / FILTER_PI :
+                         sinf(omega * n) / (FILTER_PI * n);
+            float window = 0.54f - 0.46f * cosf(2.0f * FILTER_PI * tap /
+                                                (taps - 1));
+            psDesign->pfTaps[tap] = sinc * window;
+            sum += psDesign->pfTaps[tap];
+        }
+        // Unity gain at DC.
+        for (uint32_t tap = 0; tap < taps; tap++) {
+            psDesign->pfTaps[tap] /= sum;
+        }
+        psDesign->ui32NumTaps = taps;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Sets the state as if fInitial had been the input forever, so the output
+// starts at the settled value instead of ringing up from zero.
+void filterReset(const tFilterDesign *psDesign, tFilterState *psState,
+                 float fInitial) {
+    float input = fInitial;
+
+    for (uint32_t section = 0; section < psDesign->ui32NumBiquads; section++) {
+        const tBiquad *psBiquad = &psDesign->psBiquads[section];
+        float output = input * (psBiquad->fB0 + psBiquad->fB1 + psBiquad->fB2) /
+                       (1.0f + psBiquad->fA1 + psBiquad->fA2);
+
+        psState->pfBiquadState[section][1] = psBiquad->fB2 * input -
+                                             psBiquad->fA2 * output;
+        psState->pfBiquadState[section][0] = psBiquad->fB1 * input -
+                                             psBiquad->fA1 * output +
+                                             psState->pfBiquadState[section][1];
+        input = output;
+    }
+    for (uint32_t tap = 0; tap < FILTER_MAX_TAPS; tap++) {
+        psState->pfHistory[tap] = input;
+    }
+    psState->ui32Position = 0;
+}
+
+// Runs ui32Count samples through every stage. pfIn and pfOut may be the
+// same buffer.
+void filterProcess(const tFilterDesign *psDesign, tFilterState *psState,
+                   const float *pfIn, float *pfOut, uint32_t ui32Count) {
+    const float *pfSource = pfIn;
+
+    for (uint32_t section = 0; section < psDesign->ui32NumBiquads; section++) {
+        const tBiquad *psBiquad = &psDesign->psBiquads[section];
+        float b0 = psBiquad->fB0, b1 = psBiquad->fB1, b2 = psBiquad->fB2;
+        float a1 = psBiquad->fA1, a2 = psBiquad->fA2;
+        float s1 = psState->pfBiquadState[section][0];
+        float s2 = psState->pfBiquadState[section][1];
+
+        for (uint32_t i = 0; i < ui32Count; i++) {
+            float x = pfSource[i];
+            float y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            pfOut[i] = y;
+        }
+        psState->pfBiquadState[section][0] = s1;
+        psState->pfBiquadState[section][1] = s2;
+        pfSource = pfOut;
+    }
+
+    if (psDesign->ui32NumTaps == 0) {
+        for (uint32_t i = 0; pfSource != pfOut && i < ui32Count; i++) {
+            pfOut[i] = pfSource[i];
+        }
+        return;
+    }
+
+    // The history is a ring of the last ui32NumTaps inputs.
+    for (uint32_t i = 0; i < ui32Count; i++) {
+        uint32_t position = psState->ui32Position;
+        float sum = 0.0f;
+
+        psState->pfHistory[position] = pfSource[i];
+        for (uint32_t tap = 0; tap < psDesign->ui32NumTaps; tap++) {
+            sum += psDesign->pfTaps[tap] * psState->pfHistory[position];
+            position = position ? position - 1 : psDesign->ui32NumTaps - 1;
+        }
+        pfOut[i] = sum;
+        psState->ui32Position = psState->ui32Position + 1 <
+                                psDesign->ui32NumTaps ?
+                                psState->ui32Position + 1 : 0;
+    }
+}
+
+// Designs the chain used by filterChainSample(). Every channel restarts from
+// its next sample.
+void filterChainConfigure(uint32_t ui32Type, float fSampleRate,
+                          float fCutoff) {
+    if (fSampleRate <= 0.0f) {
+        ui32Type = FILTER_NONE;
+    }
+    filterDesign(&g_sChainDesign, ui32Type, fSampleRate, fCutoff);
+    g_fChainOffset = ui32Type == FILTER_HIGHPASS ? FILTER_MID_SCALE : 0.0f;
+    for (uint32_t channel = 0; channel < FILTER_MAX_CHANNELS; channel++) {
+        g_pbChainPrimed[channel] = false;
+    }
+}
+
+// Filters one sample of one channel and returns it as an ADC count, offset to
+// mid-scale for a high-pass.
+uint32_t filterChainSample(uint32_t ui32Channel, uint32_t ui32Value) {
+    float value = (float)ui32Value;
+
+    if (ui32Channel >= FILTER_MAX_CHANNELS ||
+        (g_sChainDesign.ui32NumBiquads == 0 &&
+         g_sChainDesign.ui32NumTaps == 0)) {
+        return ui32Value;
+    }
+
+    if (!g_pbChainPrimed[ui32Channel]) {
+        filterReset(&g_sChainDesign, &g_psChainStates[ui32Channel], value);
+        g_pbChainPrimed[ui32Channel] = true;
+    }
+    filterProcess(&g_sChainDesign, &g_psChainStates[ui32Channel], &value,
+                  &value, 1);
+    value += g_fChainOffset;
+
+    if (value < 0.0f) {
+        return 0;
+    }
+    if (value > FILTER_ADC_MAX) {
+        return FILTER_ADC_MAX;
+    }
+    return (uint32_t)(value + 0.5f);
+}
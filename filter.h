@@ -0,0 +1,66 @@
+/* Purpose of the following file is to declare the per-channel filter chain
+ * applied to samples before they are displayed, sent or logged. The design
+ * and processing functions use only the C library, so coefficients can be
+ * designed and checked on the computer with the same code.
+ *
+ */
+
+#ifndef __FILTER_H__
+#define __FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FILTER_MAX_BIQUADS      4
+#define FILTER_MAX_TAPS         16
+#define FILTER_MAX_CHANNELS     8
+
+// Filter types, the values of the "filter" setting
+#define FILTER_NONE             0
+#define FILTER_LOWPASS          1   // 4th order Butterworth, two biquads
+#define FILTER_HIGHPASS         2   // 4th order Butterworth, two biquads
+#define FILTER_NOTCH            3   // One biquad, Q = 5
+#define FILTER_FIR_LOWPASS      4   // 15 tap Hamming windowed sinc
+
+// Direct form II transposed, a0 normalized to 1.
+typedef struct {
+    float fB0, fB1, fB2, fA1, fA2;
+} tBiquad;
+
+// Coefficients: the biquads run in order, then the FIR.
+typedef struct {
+    uint32_t ui32NumBiquads;
+    tBiquad psBiquads[FILTER_MAX_BIQUADS];
+    uint32_t ui32NumTaps;
+    float pfTaps[FILTER_MAX_TAPS];
+} tFilterDesign;
+
+// State of one channel running through a tFilterDesign.
+typedef struct {
+    float pfBiquadState[FILTER_MAX_BIQUADS][2];
+    float pfHistory[FILTER_MAX_TAPS];
+    uint32_t ui32Position;
+} tFilterState;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void filterDesign(tFilterDesign *psDesign, uint32_t ui32Type,
+                         float fSampleRate, float fCutoff);
+extern void filterReset(const tFilterDesign *psDesign, tFilterState *psState,
+                        float fInitial);
+extern void filterProcess(const tFilterDesign *psDesign,
+                          tFilterState *psState, const float *pfIn,
+                          float *pfOut, uint32_t ui32Count);
+
+extern void filterChainConfigure(uint32_t ui32Type, float fSampleRate,
+                                 float fCutoff);
+extern uint32_t filterChainSample(uint32_t ui32Channel, uint32_t ui32Value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FILTER_H__
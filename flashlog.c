@@ -0,0 +1,230 @@
+/* Purpose of the following file is to log ADC samples to the reserved region
+ * of the internal flash. The region is used as a circular log of 1 KB pages so
+ * every erase block wears at the same rate, and the oldest page is recycled
+ * once the log is full.
+ *
+ * Page layout (32-bit words):
+ *   [0] FLASHLOG_PAGE_MAGIC
+ *   [1] page sequence number, incremented every time a page is opened
+ *   [2] first record header, followed by its payload, then the next record...
+ *
+ * A record header holds a tag, the sample count and the payload length in
+ * bytes. The payload is programmed before its header, so a record only becomes
+ * visible once it has been completely written. A reset in the middle of a
+ * write leaves an erased header in front of programmed words, which the scan
+ * in flashLogInit() detects and closes the page. For the same reason a new
+ * page gets its sequence number before its magic word.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/flash.h"
+#include "driverlib/uart.h"
+#include "flashlog.h"
+
+#define FLASHLOG_PAGE_MAGIC     0x474F4C46  // "FLOG"
+#define FLASHLOG_ERASED         0xFFFFFFFF
+#define FLASHLOG_RECORD_TAG     0xA5000000
+#define FLASHLOG_TAG_MASK       0xFF000000
+#define FLASHLOG_HEADER_BYTES   8
+
+#define FLASHLOG_MAX_WORDS      ((CODEC_MAX_BLOCK_BYTES + 3) / 4)
+
+// Note: Kept as globals rather than on the stack, like the graphics structs
+// in ADC.c.
+static uint32_t g_ui32HeadPage;
+static uint32_t g_ui32HeadOffset;
+static uint32_t g_ui32Sequence;
+static uint16_t g_pui16Block[FLASHLOG_BLOCK_SAMPLES];
+static uint32_t g_ui32BlockCount;
+static uint32_t g_pui32Payload[FLASHLOG_MAX_WORDS];
+
+static uint32_t pageAddress(uint32_t ui32Page) {
+    return FLASHLOG_BASE + ui32Page * FLASHLOG_PAGE_SIZE;
+}
+
+static bool isErased(uint32_t ui32Address, uint32_t ui32Bytes) {
+    for (uint32_t offset = 0; offset < ui32Bytes; offset += 4) {
+        if (HWREG(ui32Address + offset) != FLASHLOG_ERASED) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Erases the page and stamps it with the next sequence number. A page that
+// fails is left as the full head page, so the next flush moves past it.
+static bool openPage(uint32_t ui32Page) {
+    uint32_t magic = FLASHLOG_PAGE_MAGIC;
+    uint32_t sequence = g_ui32Sequence + 1;
+
+    g_ui32HeadPage = ui32Page;
+    g_ui32HeadOffset = FLASHLOG_PAGE_SIZE;
+
+    if (FlashErase(pageAddress(ui32Page)) != 0 ||
+        FlashProgram(&sequence, pageAddress(ui32Page) + 4, 4) != 0 ||
+        FlashProgram(&magic, pageAddress(ui32Page), 4) != 0) {
+        return false;
+    }
+
+    g_ui32Sequence = sequence;
+    g_ui32HeadOffset = FLASHLOG_HEADER_BYTES;
+    return true;
+}
+
+// Walks the records of a page and returns the offset of the first free slot.
+// A page that holds a torn record is reported as full.
+static uint32_t findPageEnd(uint32_t ui32Page) {
+    uint32_t address = pageAddress(ui32Page);
+    uint32_t offset = FLASHLOG_HEADER_BYTES;
+
+    while (offset < FLASHLOG_PAGE_SIZE) {
+        uint32_t header = HWREG(address + offset);
+
+        if (header == FLASHLOG_ERASED) {
+            if (!isErased(address + offset, FLASHLOG_PAGE_SIZE - offset)) {
+                return FLASHLOG_PAGE_SIZE;
+            }
+            return offset;
+        }
+        if ((header & FLASHLOG_TAG_MASK) != FLASHLOG_RECORD_TAG) {
+            return FLASHLOG_PAGE_SIZE;
+        }
+        offset += 4 + (((header & 0xFFFF) + 3) & ~3);
+    }
+    return FLASHLOG_PAGE_SIZE;
+}
+
+// Finds the newest page from the sequence numbers and resumes writing there.
+void flashLogInit(void) {
+    bool found = false;
+    uint32_t newest = 0;
+
+    g_ui32BlockCount = 0;
+    g_ui32Sequence = 0;
+
+    for (uint32_t page = 0; page < FLASHLOG_NUM_PAGES; page++) {
+        uint32_t address = pageAddress(page);
+        if (HWREG(address) != FLASHLOG_PAGE_MAGIC) {
+            continue;
+        }
+        // Signed difference so the search survives sequence wrap-around.
+        if (!found || (int32_t)(HWREG(address + 4) - g_ui32Sequence) > 0) {
+            g_ui32Sequence = HWREG(address + 4);
+            newest = page;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        openPage(0);
+        return;
+    }
+
+    g_ui32HeadPage = newest;
+    g_ui32HeadOffset = findPageEnd(newest);
+}
+
+// Compresses the pending block and appends it to the log, moving on to (and
+// erasing) the next page when the record does not fit the current one. On a
+// flash error the block is dropped, so the buffer is always free for the next
+// sample whatever the result.
+bool flashLogFlush(void) {
+    uint32_t length, bytes, header, address, count;
+
+    if (g_ui32BlockCount == 0) {
+        return true;
+    }
+
+    count = g_ui32BlockCount;
+    g_ui32BlockCount = 0;
+
+    length = codecEncodeBlock(g_pui16Block, count, (uint8_t *)g_pui32Payload);
+    bytes = (length + 3) & ~3;
+
+    // Pad the last word with erased bytes.
+    for (uint32_t i = length; i < bytes; i++) {
+        ((uint8_t *)g_pui32Payload)[i] = 0xFF;
+    }
+
+    if (g_ui32HeadOffset + 4 + bytes > FLASHLOG_PAGE_SIZE) {
+        if (!openPage((g_ui32HeadPage + 1) % FLASHLOG_NUM_PAGES)) {
+            return false;
+        }
+    }
+
+    address = pageAddress(g_ui32HeadPage) + g_ui32HeadOffset;
+    header = FLASHLOG_RECORD_TAG | (count << 16) | length;
+
+    // Payload first, header last: the record is committed by the header.
+    if (FlashProgram(g_pui32Payload, address + 4, bytes) != 0 ||
+        FlashProgram(&header, address, 4) != 0) {
+        // Whatever was written is skipped by findPageEnd() on the next boot.
+        g_ui32HeadOffset = FLASHLOG_PAGE_SIZE;
+        return false;
+    }
+
+    g_ui32HeadOffset += 4 + bytes;
+    return true;
+}
+
+// Buffers one sample and writes the block out once it is full. Returns false
+// if that write failed and the block was lost.
+bool flashLogSample(uint16_t ui16Sample) {
+    if (g_ui32BlockCount >= FLASHLOG_BLOCK_SAMPLES) {
+        g_ui32BlockCount = 0;
+    }
+    g_pui16Block[g_ui32BlockCount++] = ui16Sample & 0x0FFF;
+    if (g_ui32BlockCount < FLASHLOG_BLOCK_SAMPLES) {
+        return true;
+    }
+    return flashLogFlush();
+}
+
+void flashLogErase(void) {
+    for (uint32_t page = 0; page < FLASHLOG_NUM_PAGES; page++) {
+        FlashErase(pageAddress(page));
+    }
+    flashLogInit();
+}
+
+// Sends every valid page, oldest first, as raw bytes. The dump starts with
+// "FLOG" and the page count (16 bits, little endian) so the host knows how
+// much to read. Returns the number of pages sent.
+uint32_t flashLogDump(uint32_t ui32UARTBase) {
+    uint32_t pages = 0;
+
+    for (uint32_t page = 0; page < FLASHLOG_NUM_PAGES; page++) {
+        if (HWREG(pageAddress(page)) == FLASHLOG_PAGE_MAGIC) {
+            pages++;
+        }
+    }
+
+    UARTCharPut(ui32UARTBase, 'F');
+    UARTCharPut(ui32UARTBase, 'L');
+    UARTCharPut(ui32UARTBase, 'O');
+    UARTCharPut(ui32UARTBase, 'G');
+    UARTCharPut(ui32UARTBase, pages & 0xFF);
+    UARTCharPut(ui32UARTBase, (pages >> 8) & 0xFF);
+
+    // The page after the head is the oldest one once the log has wrapped.
+    for (uint32_t i = 1; i <= FLASHLOG_NUM_PAGES; i++) {
+        uint32_t page = (g_ui32HeadPage + i) % FLASHLOG_NUM_PAGES;
+        uint32_t address = pageAddress(page);
+
+        if (HWREG(address) != FLASHLOG_PAGE_MAGIC) {
+            continue;
+        }
+        for (uint32_t offset = 0; offset < FLASHLOG_PAGE_SIZE; offset += 4) {
+            uint32_t word = HWREG(address + offset);
+
+            for (uint32_t byte = 0; byte < 4; byte++) {
+                UARTCharPut(ui32UARTBase, (word >> (8 * byte)) & 0xFF);
+            }
+        }
+    }
+    return pages;
+}
@@ -0,0 +1,40 @@
+/* Purpose of the following file is to declare the on-board sample log that
+ * stores compressed blocks of ADC samples in a reserved region of the internal
+ * flash so data is kept when the UART host is disconnected.
+ *
+ */
+
+#ifndef __FLASHLOG_H__
+#define __FLASHLOG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "codec.h"
+
+// Reserved flash region. Must match the LOGFLASH region in hello_ccs.cmd.
+#define FLASHLOG_BASE           0x00030000
+#define FLASHLOG_SIZE           0x00010000
+
+// The TM4C123 flash erases in 1 KB blocks, so one log page is one erase block.
+#define FLASHLOG_PAGE_SIZE      1024
+#define FLASHLOG_NUM_PAGES      (FLASHLOG_SIZE / FLASHLOG_PAGE_SIZE)
+
+// Number of 12-bit samples collected before a block is encoded and written.
+#define FLASHLOG_BLOCK_SAMPLES  CODEC_BLOCK_SAMPLES
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void flashLogInit(void);
+extern bool flashLogSample(uint16_t ui16Sample);
+extern bool flashLogFlush(void);
+extern void flashLogErase(void);
+extern uint32_t flashLogDump(uint32_t ui32UARTBase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASHLOG_H__
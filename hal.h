@@ -0,0 +1,175 @@
+/* Purpose of the following file is to provide direct register access for the
+ * ADC, UART and GPIO operations in the sampling loop.
+ *
+ * The driverlib versions are out-of-line calls that check their arguments
+ * with ASSERT and work out register offsets on every call. The functions
+ * here are static inline and generated per peripheral instance: the base
+ * address and sequence number are part of the function, not arguments, so
+ * each call is one or two load/store instructions and there is no way to
+ * hand an ADC function the UART base or a sequence that does not exist.
+ * Only the instances and operations the loop needs are generated;
+ * configuration still goes through driverlib.
+ *
+ * Accesses use HWREG. The host build in host/ has its own inc/hw_types.h
+ * that sends HWREG to a register simulator, so this file runs unchanged in
+ * the host tests and benchmarks.
+ *
+ */
+
+#ifndef __HAL_H__
+#define __HAL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_uart.h"
+
+// Distance between the register blocks of consecutive sample sequences.
+#define HAL_ADC_SEQ_STRIDE      (ADC_O_SSFIFO1 - ADC_O_SSFIFO0)
+
+// Sequence 0 holds the most samples.
+#define HAL_ADC_FIFO_DEPTH      8
+
+// Cortex-M4 cycle counter in the DWT, enabled through TRCENA in DEMCR.
+#define HAL_DEMCR               0xE000EDFC
+#define HAL_DEMCR_TRCENA        0x01000000
+#define HAL_DWT_CTRL            0xE0001000
+#define HAL_DWT_CTRL_CYCCNTENA  0x00000001
+#define HAL_DWT_CYCCNT          0xE0001004
+
+// Fails to compile when a generated instance has an impossible parameter.
+#define HAL_CHECK(name, condition)                                            \
+    typedef char name[(condition) ? 1 : -1]
+
+//*****************************************************************************
+//
+// HAL_ADC_SEQUENCE(Name, base, sequence) generates, for one sample sequence:
+//
+//   hal<Name>Trigger()        same as ADCProcessorTrigger(base, sequence)
+//   hal<Name>TriggerWait()    ... | ADC_TRIGGER_WAIT, sets SYNCWAIT
+//   hal<Name>TriggerSignal()  ... | ADC_TRIGGER_SIGNAL, also starts every
+//                             module waiting on SYNCWAIT
+//   hal<Name>IntStatus()      same as ADCIntStatus(base, sequence, false)
+//   hal<Name>IntClear()       same as ADCIntClear(base, sequence)
+//   hal<Name>DataGet(buffer)  same as ADCSequenceDataGet(): empties the FIFO
+//                             and returns the number of samples read
+//
+// The triggers write PSSI instead of read-modify-writing it, so Trigger()
+// also clears a SYNCWAIT left by TriggerWait().
+//
+//*****************************************************************************
+#define HAL_ADC_SEQUENCE(name, base, sequence)                                \
+    HAL_CHECK(hal##name##Check, ((base) == ADC0_BASE ||                       \
+                                 (base) == ADC1_BASE) && (sequence) < 4);     \
+                                                                              \
+    static inline void hal##name##Trigger(void) {                             \
+        HWREG((base) + ADC_O_PSSI) = 1 << (sequence);                         \
+    }                                                                         \
+                                                                              \
+    static inline void hal##name##TriggerWait(void) {                         \
+        HWREG((base) + ADC_O_PSSI) = ADC_PSSI_SYNCWAIT | (1 << (sequence));   \
+    }                                                                         \
+                                                                              \
+    static inline void hal##name##TriggerSignal(void) {                       \
+        HWREG((base) + ADC_O_PSSI) = ADC_PSSI_GSYNC | (1 << (sequence));      \
+    }                                                                         \
+                                                                              \
+    static inline bool hal##name##IntStatus(void) {                           \
+        return (HWREG((base) + ADC_O_RIS) & (1 << (sequence))) != 0;          \
+    }                                                                         \
+                                                                              \
+    static inline void hal##name##IntClear(void) {                            \
+        HWREG((base) + ADC_O_ISC) = 1 << (sequence);                          \
+    }                                                                         \
+                                                                              \
+    static inline uint32_t hal##name##DataGet(uint32_t *pui32Buffer) {        \
+        uint32_t count = 0;                                                   \
+                                                                              \
+        while (!(HWREG((base) + ADC_O_SSFSTAT0 +                              \
+                       (sequence) * HAL_ADC_SEQ_STRIDE) &                     \
+                 ADC_SSFSTAT0_EMPTY) &&                                       \
+               count < HAL_ADC_FIFO_DEPTH) {                                  \
+            pui32Buffer[count++] = HWREG((base) + ADC_O_SSFIFO0 +             \
+                                         (sequence) * HAL_ADC_SEQ_STRIDE);    \
+        }                                                                     \
+        return count;                                                         \
+    }
+
+//*****************************************************************************
+//
+// HAL_UART(Name, base) generates:
+//
+//   hal<Name>CharsAvail()     same as UARTCharsAvail(base)
+//   hal<Name>CharGet()        same as UARTCharGetNonBlocking(base): -1 if
+//                             nothing has been received
+//   hal<Name>CharPut(data)    same as UARTCharPut(base, data): waits for room
+//                             in the transmit FIFO
+//
+//*****************************************************************************
+#define HAL_UART(name, base)                                                  \
+    HAL_CHECK(hal##name##Check, (base) == UART0_BASE);                        \
+                                                                              \
+    static inline bool hal##name##CharsAvail(void) {                          \
+        return !(HWREG((base) + UART_O_FR) & UART_FR_RXFE);                   \
+    }                                                                         \
+                                                                              \
+    static inline int32_t hal##name##CharGet(void) {                          \
+        if (HWREG((base) + UART_O_FR) & UART_FR_RXFE) {                       \
+            return -1;                                                        \
+        }                                                                     \
+        return HWREG((base) + UART_O_DR);                                     \
+    }                                                                         \
+                                                                              \
+    static inline void hal##name##CharPut(uint8_t ui8Data) {                  \
+        while (HWREG((base) + UART_O_FR) & UART_FR_TXFF)                      \
+        {                                                                     \
+        }                                                                     \
+        HWREG((base) + UART_O_DR) = ui8Data;                                  \
+    }
+
+//*****************************************************************************
+//
+// HAL_GPIO_PIN(Name, base, pin) generates:
+//
+//   hal<Name>Write(on)        same as GPIOPinWrite(base, pin, on ? pin : 0).
+//                             The address bits select the pin, so the other
+//                             pins of the port are not touched.
+//
+//*****************************************************************************
+#define HAL_GPIO_PIN(name, base, pin)                                         \
+    HAL_CHECK(hal##name##Check, (pin) != 0 && ((pin) & ((pin) - 1)) == 0 &&   \
+                                (pin) <= 0x80);                               \
+                                                                              \
+    static inline void hal##name##Write(bool bOn) {                           \
+        HWREG((base) + GPIO_O_DATA + ((pin) << 2)) = bOn ? (pin) : 0;         \
+    }
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+HAL_ADC_SEQUENCE(Adc0Seq0, ADC0_BASE, 0)
+HAL_ADC_SEQUENCE(Adc1Seq0, ADC1_BASE, 0)
+HAL_UART(Uart0, UART0_BASE)
+HAL_GPIO_PIN(Led, GPIO_PORTG_BASE, 0x04)    // PG2, the status LED
+
+// Starts the free-running cycle counter. Needed once before halCycleCount().
+static inline void halCycleCounterEnable(void) {
+    HWREG(HAL_DEMCR) |= HAL_DEMCR_TRCENA;
+    HWREG(HAL_DWT_CTRL) |= HAL_DWT_CTRL_CYCCNTENA;
+}
+
+// CPU cycles since halCycleCounterEnable(), wrapping at 32 bits.
+static inline uint32_t halCycleCount(void) {
+    return HWREG(HAL_DWT_CYCCNT);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HAL_H__
@@ -44,7 +44,9 @@
 MEMORY
 {
     /* Application stored in and executes from internal flash */
-    FLASH (RX) : origin = APP_BASE, length = 0x00040000
+    FLASH (RX) : origin = APP_BASE, length = 0x00030000
+    /* Last 64 KB reserved for the sample log, see flashlog.h */
+    LOGFLASH (R) : origin = 0x00030000, length = 0x00010000
     /* Application uses internal RAM for data */
     SRAM (RWX) : origin = 0x20000000, length = 0x00008000
 }
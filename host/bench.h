@@ -0,0 +1,32 @@
+/* Purpose of the following file is to provide the timer shared by the host
+ * benchmarks. Host cycle counts only compare one version of a function with
+ * another; they do not predict cycles on the Cortex-M4.
+ *
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Host cycle counter, or nanoseconds where there is none.
+static inline uint64_t benchCycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec sTime;
+    clock_gettime(CLOCK_MONOTONIC, &sTime);
+    return (uint64_t)sTime.tv_sec * 1000000000u + sTime.tv_nsec;
+#endif
+}
+
+// Keeps the compiler from discarding a result that is never used.
+static inline void benchKeep(uint32_t ui32Value) {
+    __asm__ volatile("" : : "r"(ui32Value) : "memory");
+}
+
+#endif // __BENCH_H__
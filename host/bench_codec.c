@@ -0,0 +1,116 @@
+/* Purpose of the following file is to measure the compression ratio and the
+ * encode/decode cost of the codec.
+ *
+ * Each synthetic waveform is run, then every file named on the command line.
+ * A file holds one sample per line, as the firmware sends in ASCII output
+ * mode, so a recording is made by capturing that output to a file:
+ *
+ *   make -C host bench BENCH_ARGS="capture.txt"
+ *
+ * The ratio is against the ASCII stream, which is what the codec replaces on
+ * the UART, and against packed 12-bit samples. The rate column is the highest
+ * sample rate the stream sustains at 115200 baud, 10 bits per byte.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "codec.h"
+#include "waveforms.h"
+#include "bench.h"
+
+#define SAMPLES                 (64 * 1024)
+#define REPEATS                 20
+#define STREAM_FRAME_BYTES      3   // sync, count and length
+#define UART_BITS_PER_SECOND    115200
+
+static uint16_t g_pui16Samples[SAMPLES];
+static uint16_t g_pui16Decoded[SAMPLES];
+static uint8_t g_pui8Encoded[SAMPLES / CODEC_BLOCK_SAMPLES *
+                             CODEC_MAX_BLOCK_BYTES];
+static uint32_t g_pui32Lengths[SAMPLES / CODEC_BLOCK_SAMPLES];
+
+static void run(const char *pcName, uint32_t ui32Count) {
+    uint32_t blocks = ui32Count / CODEC_BLOCK_SAMPLES;
+    uint64_t streamBytes = 0, asciiBytes = 0, start, encode, decode;
+    bool ok = true;
+
+    if (blocks == 0) {
+        printf("%-16s fewer than %u samples\n", pcName, CODEC_BLOCK_SAMPLES);
+        return;
+    }
+    ui32Count = blocks * CODEC_BLOCK_SAMPLES;
+
+    start = benchCycles();
+    for (uint32_t repeat = 0; repeat < REPEATS; repeat++) {
+        for (uint32_t block = 0; block < blocks; block++) {
+            g_pui32Lengths[block] = codecEncodeBlock(
+                &g_pui16Samples[block * CODEC_BLOCK_SAMPLES],
+                CODEC_BLOCK_SAMPLES,
+                &g_pui8Encoded[block * CODEC_MAX_BLOCK_BYTES]);
+        }
+    }
+    encode = benchCycles() - start;
+
+    start = benchCycles();
+    for (uint32_t repeat = 0; repeat < REPEATS; repeat++) {
+        for (uint32_t block = 0; block < blocks; block++) {
+            ok &= codecDecodeBlock(
+                &g_pui8Encoded[block * CODEC_MAX_BLOCK_BYTES],
+                g_pui32Lengths[block],
+                &g_pui16Decoded[block * CODEC_BLOCK_SAMPLES],
+                CODEC_BLOCK_SAMPLES);
+        }
+    }
+    decode = benchCycles() - start;
+
+    for (uint32_t block = 0; block < blocks; block++) {
+        streamBytes += STREAM_FRAME_BYTES + g_pui32Lengths[block];
+    }
+    for (uint32_t i = 0; i < ui32Count; i++) {
+        ok &= g_pui16Decoded[i] == g_pui16Samples[i];
+        asciiBytes += snprintf(NULL, 0, "%u\r\n", g_pui16Samples[i]);
+    }
+
+    printf("%-16s %6.2f %6.2f %9.0f %8.1f %8.1f %s\n", pcName,
+           (double)asciiBytes / streamBytes,
+           ui32Count * 1.5 / streamBytes,
+           UART_BITS_PER_SECOND / 10.0 * ui32Count / streamBytes,
+           (double)encode / REPEATS / ui32Count,
+           (double)decode / REPEATS / ui32Count,
+           ok ? "" : "ROUND TRIP FAILED");
+}
+
+static uint32_t load(const char *pcPath) {
+    FILE *psFile = fopen(pcPath, "r");
+    uint32_t count = 0;
+    unsigned value;
+
+    if (psFile == NULL) {
+        perror(pcPath);
+        return 0;
+    }
+    while (count < SAMPLES && fscanf(psFile, "%u", &value) == 1) {
+        g_pui16Samples[count++] = value & 0x0FFF;
+    }
+    fclose(psFile);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    printf("codec: %u-sample blocks, cycles are host cycles per sample\n",
+           CODEC_BLOCK_SAMPLES);
+    printf("%-16s %6s %6s %9s %8s %8s\n", "waveform", "/ascii", "/12bit",
+           "max Hz", "encode", "decode");
+
+    for (tWaveform wave = 0; wave < WAVE_NUM; wave++) {
+        waveGenerate(wave, g_pui16Samples, SAMPLES);
+        run(waveName(wave), SAMPLES);
+    }
+    for (int arg = 1; arg < argc; arg++) {
+        run(argv[arg], load(argv[arg]));
+    }
+    return 0;
+}
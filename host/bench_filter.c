@@ -0,0 +1,73 @@
+/* Purpose of the following file is to measure host cycles per sample of each
+ * filter type, processed in blocks and one sample at a time as the firmware
+ * chain does, and through filterChainSample() including the conversion to
+ * and from ADC counts.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "filter.h"
+#include "waveforms.h"
+#include "bench.h"
+
+#define SAMPLES                 (64 * 1024)
+#define REPEATS                 20
+
+static uint16_t g_pui16Wave[SAMPLES];
+static float g_pfIn[SAMPLES];
+static float g_pfOut[SAMPLES];
+
+static double perSample(const tFilterDesign *psDesign, uint32_t ui32Block) {
+    tFilterState sState;
+    uint64_t start;
+
+    filterReset(psDesign, &sState, g_pfIn[0]);
+    start = benchCycles();
+    for (uint32_t repeat = 0; repeat < REPEATS; repeat++) {
+        for (uint32_t i = 0; i < SAMPLES; i += ui32Block) {
+            filterProcess(psDesign, &sState, &g_pfIn[i], &g_pfOut[i],
+                          ui32Block);
+        }
+    }
+    return (double)(benchCycles() - start) / REPEATS / SAMPLES;
+}
+
+static double chainPerSample(uint32_t ui32Type) {
+    uint32_t sum = 0;
+    uint64_t start;
+
+    filterChainConfigure(ui32Type, 10000.0f, 500.0f);
+    start = benchCycles();
+    for (uint32_t repeat = 0; repeat < REPEATS; repeat++) {
+        for (uint32_t i = 0; i < SAMPLES; i++) {
+            sum += filterChainSample(i & 3, g_pui16Wave[i]);
+        }
+    }
+    benchKeep(sum);
+    return (double)(benchCycles() - start) / REPEATS / SAMPLES;
+}
+
+int main(void) {
+    static const char *ppcNames[] = { "none", "lowpass", "highpass", "notch",
+                                      "fir" };
+
+    waveGenerate(WAVE_NOISY_SINE, g_pui16Wave, SAMPLES);
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        g_pfIn[i] = g_pui16Wave[i];
+    }
+
+    printf("filter: host cycles per sample\n");
+    printf("%-10s %8s %8s %8s %8s\n", "type", "block 64", "block 8",
+           "single", "chain");
+    for (uint32_t type = FILTER_NONE; type <= FILTER_FIR_LOWPASS; type++) {
+        tFilterDesign sDesign;
+
+        filterDesign(&sDesign, type, 10000.0f, 500.0f);
+        printf("%-10s %8.1f %8.1f %8.1f %8.1f\n", ppcNames[type],
+               perSample(&sDesign, 64), perSample(&sDesign, 8),
+               perSample(&sDesign, 1), chainPerSample(type));
+        benchKeep((uint32_t)g_pfOut[SAMPLES - 1]);
+    }
+    return 0;
+}
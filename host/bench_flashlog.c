@@ -0,0 +1,68 @@
+/* Purpose of the following file is to measure the sustained rate at which
+ * the flash log can store samples. Each waveform is logged through
+ * flashLogSample() until the page ring has wrapped several times, and the
+ * rate comes from the erase and program time the flash model charges, so
+ * every page erase is included. Host CPU time is not counted: the flash
+ * controller is the bottleneck, and the encoder's cost is in bench_codec.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "flashlog.h"
+#include "waveforms.h"
+#include "sim.h"
+
+#define SAMPLES                 (64 * 1024)
+#define PASSES                  8
+
+static uint16_t g_pui16Samples[SAMPLES];
+
+static void run(tWaveform eWave) {
+    uint32_t failures = 0;
+    uint64_t logged = (uint64_t)SAMPLES * PASSES;
+    double seconds, eraseSeconds;
+
+    waveGenerate(eWave, g_pui16Samples, SAMPLES);
+
+    simReset();
+    simFlashReset();
+    flashLogInit();
+    g_ui64SimFlashTimeUs = 0;
+    g_ui32SimFlashErases = 0;
+    g_ui32SimFlashWords = 0;
+
+    for (uint32_t pass = 0; pass < PASSES; pass++) {
+        for (uint32_t i = 0; i < SAMPLES; i++) {
+            if (!flashLogSample(g_pui16Samples[i])) {
+                failures++;
+            }
+        }
+    }
+    if (!flashLogFlush()) {
+        failures++;
+    }
+
+    seconds = g_ui64SimFlashTimeUs / 1e6;
+    eraseSeconds = g_ui32SimFlashErases * (SIM_FLASH_ERASE_US / 1e6);
+    printf("%-12s %7.2f %7u %8.2f %8.2f %9.0f %s\n", waveName(eWave),
+           g_ui32SimFlashWords * 4.0 / logged, g_ui32SimFlashErases,
+           (seconds - eraseSeconds) * 1000 / PASSES,
+           eraseSeconds * 1000 / PASSES, logged / seconds,
+           failures ? "WRITE FAILED" : "");
+}
+
+int main(void) {
+    printf("flashlog: %u samples per waveform, %u us erase, %u us per word\n",
+           SAMPLES * PASSES, SIM_FLASH_ERASE_US, SIM_FLASH_PROGRAM_US);
+    printf("%-12s %7s %7s %8s %8s %9s\n", "waveform", "B/smpl", "erases",
+           "prog ms", "erase ms", "max Hz");
+    printf("%-12s %7s %7s %8s %8s %9s\n", "", "", "", "per 64K", "per 64K",
+           "");
+
+    for (tWaveform wave = 0; wave < WAVE_NUM; wave++) {
+        run(wave);
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+/* Purpose of the following file is to run the firmware's sampling benchmark
+ * in cyclebench.c on the host.
+ *
+ * This is not a comparison with driverlib. On the host, the driverlib path
+ * of cycleBenchSampling() calls the simplified stand-ins in sim_adc.c, so
+ * the second row only checks that the stand-ins make the same register
+ * accesses per read as the HAL, and that the benchmark runs. Host cycles
+ * are dominated by the simulator and say nothing about the target. The HAL
+ * against driverlib comparison is the 'B' command on the board.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "cyclebench.h"
+#include "sim.h"
+#include "bench.h"
+
+#define ITERATIONS              100000
+#define RUNS                    5
+#define STEPS                   8
+
+// Reads of the cycle counter that cycleBenchSampling() makes per iteration.
+#define COUNTER_READS           4
+
+static void setup(void) {
+    simReset();
+    simAdcReset(NULL);
+    for (uint32_t step = 0; step < STEPS; step++) {
+        ADCSequenceStepConfigure(ADC0_BASE, 0, step, step |
+                                 (step == STEPS - 1 ? ADC_CTL_IE |
+                                                      ADC_CTL_END : 0));
+    }
+    ADCSequenceEnable(ADC0_BASE, 0);
+}
+
+int main(void) {
+    static const char *ppcPaths[] = { "hal", "stand-ins" };
+
+    printf("hal: ADC0 sequence 0 read, %u steps, host stand-ins, not "
+           "driverlib;\n     compare with driverlib using 'B' on the board\n",
+           STEPS);
+    printf("%-10s %9s %12s %12s\n", "path", "accesses", "host total",
+           "host access");
+    for (uint32_t path = CYCLEBENCH_HAL; path <= CYCLEBENCH_DRIVERLIB;
+         path++) {
+        tCycleBenchResult sResult, sBest = { UINT32_MAX, UINT32_MAX };
+        uint32_t accesses = 0;
+
+        // Best of several runs, to keep other host activity out of it.
+        for (uint32_t run = 0; run < RUNS; run++) {
+            setup();
+            accesses = g_ui32SimAccesses;
+            cycleBenchSampling(path, ITERATIONS, &sResult);
+            accesses = g_ui32SimAccesses - accesses;
+            if (sResult.ui32Total < sBest.ui32Total) {
+                sBest.ui32Total = sResult.ui32Total;
+            }
+            if (sResult.ui32Access < sBest.ui32Access) {
+                sBest.ui32Access = sResult.ui32Access;
+            }
+        }
+
+        printf("%-10s %9.1f %12u %12u\n", ppcPaths[path],
+               (double)accesses / ITERATIONS - COUNTER_READS,
+               sBest.ui32Total, sBest.ui32Access);
+    }
+    return 0;
+}
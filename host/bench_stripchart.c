@@ -0,0 +1,64 @@
+/* Purpose of the following file is to measure the cost of a strip chart frame:
+ * pixels sent to the display (each is one 16-bit write to the OLED) and host
+ * cycles, for an incremental frame and for a full redraw, and the cost of
+ * folding in one sample.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "grlib/grlib.h"
+#include "grlib_stub.h"
+#include "stripchart.h"
+#include "waveforms.h"
+#include "bench.h"
+
+#define FRAMES                  100000
+#define SAMPLES_PER_FRAME       100
+
+static tContext g_sContext;
+static uint16_t g_pui16Wave[FRAMES];
+
+int main(void) {
+    uint64_t start, cycles = 0, redrawCycles = 0, sampleCycles = 0;
+    uint64_t pixels = 0, redrawPixels = 0;
+    uint32_t frames = 0, redraws = 0;
+
+    waveGenerate(WAVE_NOISY_SINE, g_pui16Wave, FRAMES);
+    grStubReset(ClrBlack);
+    stripChartInit(&g_sContext);
+
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        start = benchCycles();
+        for (uint32_t sample = 0; sample < SAMPLES_PER_FRAME; sample++) {
+            stripChartSample(g_pui16Wave[(i + sample) % FRAMES]);
+        }
+        sampleCycles += benchCycles() - start;
+
+        grStubClearCounts();
+        start = benchCycles();
+        stripChartDraw();
+        start = benchCycles() - start;
+        if (g_ui32GrRectFills) {
+            redraws++;
+            redrawCycles += start;
+            redrawPixels += g_ui32GrPixels;
+        } else {
+            frames++;
+            cycles += start;
+            pixels += g_ui32GrPixels;
+        }
+    }
+
+    printf("stripchart: host cycles, pixels written to the OLED\n");
+    printf("%-12s %8s %10s %8s\n", "", "frames", "cycles", "pixels");
+    printf("%-12s %8u %10.0f %8.0f\n", "incremental", frames,
+           (double)cycles / frames, (double)pixels / frames);
+    if (redraws) {
+        printf("%-12s %8u %10.0f %8.0f\n", "redraw", redraws,
+               (double)redrawCycles / redraws, (double)redrawPixels / redraws);
+    }
+    printf("%-12s %8s %10.1f\n", "per sample", "",
+           (double)sampleCycles / FRAMES / SAMPLES_PER_FRAME);
+    return 0;
+}
@@ -0,0 +1,27 @@
+/* Purpose of the following file is to provide the minimal check macros shared
+ * by the host tests. A failed check prints its location and the test keeps
+ * going; main() returns the failure count.
+ *
+ */
+
+#ifndef __CHECK_H__
+#define __CHECK_H__
+
+#include <stdio.h>
+
+static int g_iCheckFailures = 0;
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__,           \
+                   #condition);                                               \
+            g_iCheckFailures++;                                               \
+        }                                                                     \
+    } while (0)
+
+#define CHECK_DONE()                                                          \
+    (printf("%s: %s\n", __FILE__, g_iCheckFailures ? "FAILED" : "passed"),    \
+     g_iCheckFailures != 0)
+
+#endif // __CHECK_H__
@@ -0,0 +1,65 @@
+/* Purpose of the following file is to stand in for grlib and the OLED driver
+ * in the host build. Drawing calls render into a 96x64 framebuffer of colors
+ * and are counted, so tests can check what was drawn and how much of the
+ * display each frame touched.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "grlib/grlib.h"
+#include "grlib_stub.h"
+
+uint32_t g_ppui32Framebuffer[GRSTUB_HEIGHT][GRSTUB_WIDTH];
+uint32_t g_ui32GrPixels;
+uint32_t g_ui32GrRectFills;
+uint32_t g_ui32GrLines;
+
+void grStubReset(uint32_t ui32Color) {
+    for (uint32_t y = 0; y < GRSTUB_HEIGHT; y++) {
+        for (uint32_t x = 0; x < GRSTUB_WIDTH; x++) {
+            g_ppui32Framebuffer[y][x] = ui32Color;
+        }
+    }
+    grStubClearCounts();
+}
+
+void grStubClearCounts(void) {
+    g_ui32GrPixels = 0;
+    g_ui32GrRectFills = 0;
+    g_ui32GrLines = 0;
+}
+
+static void plot(int32_t i32X, int32_t i32Y, uint32_t ui32Color) {
+    if (i32X >= 0 && i32X < GRSTUB_WIDTH && i32Y >= 0 && i32Y < GRSTUB_HEIGHT) {
+        g_ppui32Framebuffer[i32Y][i32X] = ui32Color;
+        g_ui32GrPixels++;
+    }
+}
+
+void GrContextForegroundSet(tContext *psContext, uint32_t ui32Value) {
+    psContext->ui32Foreground = ui32Value;
+}
+
+void GrLineDrawV(const tContext *psContext, int32_t i32X, int32_t i32Y1,
+                 int32_t i32Y2) {
+    if (i32Y1 > i32Y2) {
+        int32_t swap = i32Y1;
+        i32Y1 = i32Y2;
+        i32Y2 = swap;
+    }
+    for (int32_t y = i32Y1; y <= i32Y2; y++) {
+        plot(i32X, y, psContext->ui32Foreground);
+    }
+    g_ui32GrLines++;
+}
+
+void GrRectFill(const tContext *psContext, const tRectangle *psRect) {
+    for (int32_t y = psRect->i16YMin; y <= psRect->i16YMax; y++) {
+        for (int32_t x = psRect->i16XMin; x <= psRect->i16XMax; x++) {
+            plot(x, y, psContext->ui32Foreground);
+        }
+    }
+    g_ui32GrRectFills++;
+}
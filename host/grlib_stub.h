@@ -0,0 +1,25 @@
+/* Purpose of the following file is to declare the framebuffer and counters of
+ * the host grlib stand-in.
+ *
+ */
+
+#ifndef __GRLIB_STUB_H__
+#define __GRLIB_STUB_H__
+
+#include <stdint.h>
+
+#define GRSTUB_WIDTH            96
+#define GRSTUB_HEIGHT           64
+
+// Indexed [y][x], one grlib color per pixel.
+extern uint32_t g_ppui32Framebuffer[GRSTUB_HEIGHT][GRSTUB_WIDTH];
+
+// Pixels written and calls made since the last grStubClearCounts().
+extern uint32_t g_ui32GrPixels;
+extern uint32_t g_ui32GrRectFills;
+extern uint32_t g_ui32GrLines;
+
+extern void grStubReset(uint32_t ui32Color);
+extern void grStubClearCounts(void);
+
+#endif // __GRLIB_STUB_H__
@@ -0,0 +1,48 @@
+//*****************************************************************************
+//
+// adc.h - Host stand-in for the driverlib ADC API, implemented on the
+// simulated registers in host/sim_adc.c.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_ADC_H__
+#define __DRIVERLIB_ADC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADC_TRIGGER_PROCESSOR   0x00000000
+#define ADC_TRIGGER_WAIT        0x08000000
+#define ADC_TRIGGER_SIGNAL      0x80000000
+
+#define ADC_CTL_IE              0x00000040
+#define ADC_CTL_END             0x00000020
+#define ADC_CTL_D               0x00000010
+#define ADC_CTL_CH0             0x00000000
+#define ADC_CTL_CH5             0x00000005
+#define ADC_CTL_CH6             0x00000006
+#define ADC_CTL_CH7             0x00000007
+#define ADC_CTL_CH16            0x00000100
+#define ADC_CTL_CH23            0x00000107
+
+#define ADC_PHASE_0             0x00000000
+#define ADC_PHASE_180           0x00000008
+
+extern void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                                 uint32_t ui32Trigger, uint32_t ui32Priority);
+extern void ADCSequenceStepConfigure(uint32_t ui32Base,
+                                     uint32_t ui32SequenceNum,
+                                     uint32_t ui32Step, uint32_t ui32Config);
+extern int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                                  uint32_t *pui32Buffer);
+extern void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern uint32_t ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                             bool bMasked);
+extern void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCPhaseDelaySet(uint32_t ui32Base, uint32_t ui32Phase);
+extern void ADCHardwareOversampleConfigure(uint32_t ui32Base,
+                                           uint32_t ui32Factor);
+
+#endif // __DRIVERLIB_ADC_H__
@@ -0,0 +1,21 @@
+//*****************************************************************************
+//
+// eeprom.h - Host stand-in for the driverlib EEPROM API, backed by a RAM
+// array in host/sim_eeprom.c.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_EEPROM_H__
+#define __DRIVERLIB_EEPROM_H__
+
+#include <stdint.h>
+
+#define EEPROM_INIT_OK          0
+
+extern uint32_t EEPROMInit(void);
+extern void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address,
+                       uint32_t ui32Count);
+extern uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address,
+                              uint32_t ui32Count);
+
+#endif // __DRIVERLIB_EEPROM_H__
@@ -0,0 +1,23 @@
+//*****************************************************************************
+//
+// gpio.h - Host stand-in for the driverlib GPIO API, backed by the GPIO
+// model in host/sim_timer.c.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_GPIO_H__
+#define __DRIVERLIB_GPIO_H__
+
+#include <stdint.h>
+
+#define GPIO_PIN_0              0x00000001
+#define GPIO_PIN_1              0x00000002
+#define GPIO_PIN_2              0x00000004
+#define GPIO_PIN_3              0x00000008
+#define GPIO_PIN_4              0x00000010
+
+extern void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins);
+extern void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+extern int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins);
+
+#endif // __DRIVERLIB_GPIO_H__
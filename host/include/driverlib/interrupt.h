@@ -0,0 +1,18 @@
+//*****************************************************************************
+//
+// interrupt.h - Host stand-in for the driverlib interrupt API. The host tests
+// call interrupt handlers directly, so these do nothing.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_INTERRUPT_H__
+#define __DRIVERLIB_INTERRUPT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern void IntEnable(uint32_t ui32Interrupt);
+extern void IntPendClear(uint32_t ui32Interrupt);
+extern bool IntMasterEnable(void);
+
+#endif // __DRIVERLIB_INTERRUPT_H__
@@ -0,0 +1,24 @@
+//*****************************************************************************
+//
+// sysctl.h - Host stand-in for the driverlib system control API. The
+// simulated system clock runs at 16 MHz like the board.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_SYSCTL_H__
+#define __DRIVERLIB_SYSCTL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SYSCTL_PERIPH_ADC0      0xf0003800
+#define SYSCTL_PERIPH_ADC1      0xf0003801
+#define SYSCTL_PERIPH_EEPROM0   0xf0005800
+#define SYSCTL_PERIPH_GPIOG     0xf0000806
+#define SYSCTL_PERIPH_TIMER2    0xf0000402
+
+extern void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+extern bool SysCtlPeripheralReady(uint32_t ui32Peripheral);
+extern uint32_t SysCtlClockGet(void);
+
+#endif // __DRIVERLIB_SYSCTL_H__
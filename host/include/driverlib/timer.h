@@ -0,0 +1,28 @@
+//*****************************************************************************
+//
+// timer.h - Host stand-in for the driverlib timer API, backed by the timer
+// model in host/sim_timer.c.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_TIMER_H__
+#define __DRIVERLIB_TIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMER_CFG_ONE_SHOT      0x00000021
+#define TIMER_CFG_PERIODIC      0x00000022
+#define TIMER_A                 0x000000ff
+#define TIMER_TIMA_TIMEOUT      0x00000001
+
+extern void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config);
+extern void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer,
+                         uint32_t ui32Value);
+extern void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer);
+extern void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer);
+extern void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked);
+
+#endif // __DRIVERLIB_TIMER_H__
@@ -0,0 +1,18 @@
+//*****************************************************************************
+//
+// uart.h - Host stand-in for the driverlib UART API. Transmitted bytes are
+// captured by host/sim.c.
+//
+//*****************************************************************************
+
+#ifndef __DRIVERLIB_UART_H__
+#define __DRIVERLIB_UART_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+extern bool UARTCharsAvail(uint32_t ui32Base);
+extern int32_t UARTCharGetNonBlocking(uint32_t ui32Base);
+
+#endif // __DRIVERLIB_UART_H__
@@ -0,0 +1,35 @@
+//*****************************************************************************
+//
+// grlib.h - Host stand-in for the parts of grlib used by this project. The
+// drawing calls render into the framebuffer in host/grlib_stub.c.
+//
+//*****************************************************************************
+
+#ifndef __GRLIB_H__
+#define __GRLIB_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    int16_t i16XMin;
+    int16_t i16YMin;
+    int16_t i16XMax;
+    int16_t i16YMax;
+} tRectangle;
+
+typedef struct {
+    uint32_t ui32Foreground;
+} tContext;
+
+#define ClrBlack                0x00000000
+#define ClrDarkBlue             0x0000008B
+#define ClrYellow               0x00FFFF00
+#define ClrWhite                0x00FFFFFF
+
+extern void GrContextForegroundSet(tContext *psContext, uint32_t ui32Value);
+extern void GrLineDrawV(const tContext *psContext, int32_t i32X,
+                        int32_t i32Y1, int32_t i32Y2);
+extern void GrRectFill(const tContext *psContext, const tRectangle *psRect);
+
+#endif // __GRLIB_H__
@@ -0,0 +1,24 @@
+//*****************************************************************************
+//
+// hw_adc.h - Host stand-in: the ADC register offsets and bits used by this
+// project, with the TivaWare values.
+//
+//*****************************************************************************
+
+#ifndef __HW_ADC_H__
+#define __HW_ADC_H__
+
+#define ADC_O_ACTSS             0x00000000
+#define ADC_O_RIS               0x00000004
+#define ADC_O_ISC               0x0000000C
+#define ADC_O_PSSI              0x00000028
+#define ADC_O_SAC               0x00000030
+#define ADC_O_SSFIFO0           0x00000048
+#define ADC_O_SSFSTAT0          0x0000004C
+#define ADC_O_SSFIFO1           0x00000068
+
+#define ADC_PSSI_GSYNC          0x80000000
+#define ADC_PSSI_SYNCWAIT       0x08000000
+#define ADC_SSFSTAT0_EMPTY      0x00000100
+
+#endif // __HW_ADC_H__
@@ -0,0 +1,12 @@
+//*****************************************************************************
+//
+// hw_gpio.h - Host stand-in: the GPIO register offsets used by this project.
+//
+//*****************************************************************************
+
+#ifndef __HW_GPIO_H__
+#define __HW_GPIO_H__
+
+#define GPIO_O_DATA             0x00000000
+
+#endif // __HW_GPIO_H__
@@ -0,0 +1,16 @@
+//*****************************************************************************
+//
+// hw_ints.h - Host stand-in: the interrupt numbers used by this project.
+//
+//*****************************************************************************
+
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+#define INT_UART0               21
+#define INT_ADC0SS0             30
+#define INT_TIMER0A             35
+#define INT_TIMER1A             37
+#define INT_TIMER2A             39
+
+#endif // __HW_INTS_H__
@@ -0,0 +1,22 @@
+//*****************************************************************************
+//
+// hw_memmap.h - Host stand-in: the base addresses used by this project, with
+// the TivaWare values.
+//
+//*****************************************************************************
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+#define FLASH_BASE              0x00000000
+#define GPIO_PORTA_BASE         0x40004000
+#define UART0_BASE              0x4000C000
+#define GPIO_PORTG_BASE         0x40026000
+#define TIMER0_BASE             0x40030000
+#define TIMER1_BASE             0x40031000
+#define TIMER2_BASE             0x40032000
+#define ADC0_BASE               0x40038000
+#define ADC1_BASE               0x40039000
+#define GPIO_PORTM_BASE         0x40063000
+
+#endif // __HW_MEMMAP_H__
@@ -0,0 +1,20 @@
+//*****************************************************************************
+//
+// hw_types.h - Host stand-in for the TivaWare header of the same name.
+//
+// Register accesses go through simReg() in host/sim.c, which maps target
+// addresses onto the simulated flash and peripheral registers.
+//
+//*****************************************************************************
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern volatile uint32_t *simReg(uint32_t ui32Address);
+
+#define HWREG(x)                (*simReg((uint32_t)(x)))
+
+#endif // __HW_TYPES_H__
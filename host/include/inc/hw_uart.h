@@ -0,0 +1,17 @@
+//*****************************************************************************
+//
+// hw_uart.h - Host stand-in: the UART register offsets and bits used by this
+// project, with the TivaWare values.
+//
+//*****************************************************************************
+
+#ifndef __HW_UART_H__
+#define __HW_UART_H__
+
+#define UART_O_DR               0x00000000
+#define UART_O_FR               0x00000018
+
+#define UART_FR_TXFF            0x00000020
+#define UART_FR_RXFE            0x00000010
+
+#endif // __HW_UART_H__
@@ -0,0 +1,239 @@
+/* Purpose of the following file is to map target register addresses onto
+ * host memory.
+ *
+ * HWREG(x) calls simReg(x) and dereferences the pointer it returns, so the
+ * simulator cannot see directly whether an access was a read or a write.
+ * Instead simReg() runs the block's read hook before handing out a register,
+ * remembers its value, and on the next simReg() (or simSync()) call compares
+ * it again: a changed value is passed to the write hook. Writing the value a
+ * register already holds is therefore invisible, which the models avoid by
+ * loading read values that no meaningful write can repeat.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "sim.h"
+#include "bench.h"
+
+#define SIM_BLOCK_SIZE          0x1000
+#define SIM_MAX_BLOCKS          16
+#define SIM_UART_CAPTURE        (256 * 1024)
+
+// Read back from UART DR while the receive FIFO is empty. Never equal to a
+// transmitted byte, so every write is seen.
+#define SIM_UART_DR_IDLE        0xFFFFFFFF
+
+// Cortex-M4 debug registers behind the cycle counter.
+#define SIM_SCS_BASE            0xE000E000
+#define SIM_DEMCR               0x00000DFC
+#define SIM_DEMCR_TRCENA        0x01000000
+#define SIM_DWT_BASE            0xE0001000
+#define SIM_DWT_CTRL            0x00000000
+#define SIM_DWT_CTRL_CYCCNTENA  0x00000001
+#define SIM_DWT_CYCCNT          0x00000004
+
+typedef struct {
+    uint32_t ui32Base;
+    tSimReadHook pfnRead;
+    tSimWriteHook pfnWrite;
+    volatile uint32_t pui32Regs[SIM_BLOCK_SIZE / 4];
+} tSimBlock;
+
+static tSimBlock g_psBlocks[SIM_MAX_BLOCKS];
+static uint32_t g_ui32NumBlocks;
+
+// The register handed out by the last simReg() call, and its value then.
+static tSimBlock *g_psPendingBlock;
+static volatile uint32_t *g_pui32Pending;
+static uint32_t g_ui32PendingValue;
+
+static uint8_t g_pui8UartCapture[SIM_UART_CAPTURE];
+static uint32_t g_ui32UartCaptured;
+
+static bool g_bTraceEnabled;
+static bool g_bCycleCounting;
+
+uint32_t g_ui32SimAccesses;
+
+static void uartRead(uint32_t ui32Base, uint32_t ui32Offset,
+                     volatile uint32_t *pui32Reg) {
+    if (ui32Offset == UART_O_FR) {
+        // Transmit FIFO never full, receive FIFO always empty.
+        *pui32Reg = UART_FR_RXFE;
+    } else if (ui32Offset == UART_O_DR) {
+        *pui32Reg = SIM_UART_DR_IDLE;
+    }
+}
+
+static void uartWrite(uint32_t ui32Base, uint32_t ui32Offset,
+                      uint32_t ui32Value, volatile uint32_t *pui32Reg) {
+    if (ui32Offset == UART_O_DR && g_ui32UartCaptured < SIM_UART_CAPTURE) {
+        g_pui8UartCapture[g_ui32UartCaptured++] = ui32Value & 0xFF;
+    }
+}
+
+static void scsWrite(uint32_t ui32Base, uint32_t ui32Offset,
+                     uint32_t ui32Value, volatile uint32_t *pui32Reg) {
+    if (ui32Offset == SIM_DEMCR) {
+        g_bTraceEnabled = (ui32Value & SIM_DEMCR_TRCENA) != 0;
+    }
+}
+
+// CYCCNT follows the host cycle counter while it is enabled, so cycle counts
+// taken by the firmware measure the host time of the code in between.
+static void dwtRead(uint32_t ui32Base, uint32_t ui32Offset,
+                    volatile uint32_t *pui32Reg) {
+    if (ui32Offset == SIM_DWT_CYCCNT && g_bTraceEnabled && g_bCycleCounting) {
+        *pui32Reg = (uint32_t)benchCycles();
+    }
+}
+
+static void dwtWrite(uint32_t ui32Base, uint32_t ui32Offset,
+                     uint32_t ui32Value, volatile uint32_t *pui32Reg) {
+    if (ui32Offset == SIM_DWT_CTRL) {
+        g_bCycleCounting = (ui32Value & SIM_DWT_CTRL_CYCCNTENA) != 0;
+    }
+}
+
+// Hands the pending write, if any, to its block's write hook.
+void simSync(void) {
+    tSimBlock *psBlock = g_psPendingBlock;
+
+    if (psBlock == NULL) {
+        return;
+    }
+    g_psPendingBlock = NULL;
+    if (*g_pui32Pending != g_ui32PendingValue && psBlock->pfnWrite) {
+        psBlock->pfnWrite(psBlock->ui32Base,
+                          (uint32_t)((g_pui32Pending - psBlock->pui32Regs) * 4),
+                          *g_pui32Pending, g_pui32Pending);
+    }
+}
+
+void simMapBlock(uint32_t ui32Base, tSimReadHook pfnRead,
+                 tSimWriteHook pfnWrite) {
+    tSimBlock *psBlock;
+
+    if (g_ui32NumBlocks == SIM_MAX_BLOCKS) {
+        fprintf(stderr, "sim: too many register blocks\n");
+        abort();
+    }
+    psBlock = &g_psBlocks[g_ui32NumBlocks++];
+    memset((void *)psBlock, 0, sizeof(*psBlock));
+    psBlock->ui32Base = ui32Base;
+    psBlock->pfnRead = pfnRead;
+    psBlock->pfnWrite = pfnWrite;
+}
+
+// Unmaps every block and maps the UART and the cycle counter. Models map
+// their own blocks in their reset functions.
+void simReset(void) {
+    g_psPendingBlock = NULL;
+    g_ui32NumBlocks = 0;
+    g_ui32UartCaptured = 0;
+    g_ui32SimAccesses = 0;
+    g_bTraceEnabled = false;
+    g_bCycleCounting = false;
+    simMapBlock(UART0_BASE, uartRead, uartWrite);
+    simMapBlock(SIM_SCS_BASE, NULL, scsWrite);
+    simMapBlock(SIM_DWT_BASE, dwtRead, dwtWrite);
+}
+
+volatile uint32_t *simReg(uint32_t ui32Address) {
+    uint32_t base = ui32Address & ~(SIM_BLOCK_SIZE - 1);
+    uint32_t offset = ui32Address & (SIM_BLOCK_SIZE - 1);
+
+    simSync();
+    g_ui32SimAccesses++;
+
+    if (ui32Address < SIM_FLASH_SIZE) {
+        extern volatile uint32_t *simFlashWord(uint32_t ui32Address);
+        return simFlashWord(ui32Address);
+    }
+
+    for (uint32_t block = 0; block < g_ui32NumBlocks; block++) {
+        tSimBlock *psBlock = &g_psBlocks[block];
+        volatile uint32_t *pui32Reg;
+
+        if (psBlock->ui32Base != base) {
+            continue;
+        }
+        pui32Reg = &psBlock->pui32Regs[offset / 4];
+        if (psBlock->pfnRead) {
+            psBlock->pfnRead(base, offset, pui32Reg);
+        }
+        g_psPendingBlock = psBlock;
+        g_pui32Pending = pui32Reg;
+        g_ui32PendingValue = *pui32Reg;
+        return pui32Reg;
+    }
+
+    fprintf(stderr, "sim: access to unmapped address 0x%08x\n", ui32Address);
+    abort();
+}
+
+// Copies out everything sent on UART0 so far and returns its length.
+uint32_t simUartOutput(uint8_t *pui8Buffer, uint32_t ui32Size) {
+    simSync();
+    if (ui32Size > g_ui32UartCaptured) {
+        ui32Size = g_ui32UartCaptured;
+    }
+    memcpy(pui8Buffer, g_pui8UartCapture, ui32Size);
+    return g_ui32UartCaptured;
+}
+
+void simUartClear(void) {
+    simSync();
+    g_ui32UartCaptured = 0;
+}
+
+//*****************************************************************************
+//
+// driverlib stand-ins that only need the register core.
+//
+//*****************************************************************************
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData) {
+    HWREG(ui32Base + UART_O_DR) = ucData;
+}
+
+bool UARTCharsAvail(uint32_t ui32Base) {
+    return !(HWREG(ui32Base + UART_O_FR) & UART_FR_RXFE);
+}
+
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base) {
+    if (HWREG(ui32Base + UART_O_FR) & UART_FR_RXFE) {
+        return -1;
+    }
+    return HWREG(ui32Base + UART_O_DR);
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) {
+    return true;
+}
+
+uint32_t SysCtlClockGet(void) {
+    return 16000000;
+}
+
+void IntEnable(uint32_t ui32Interrupt) {
+}
+
+void IntPendClear(uint32_t ui32Interrupt) {
+}
+
+bool IntMasterEnable(void) {
+    return false;
+}
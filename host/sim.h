@@ -0,0 +1,103 @@
+/* Purpose of the following file is to declare the host simulator that lets
+ * the firmware modules build and run on the computer. Register accesses made
+ * through HWREG land in simulated register blocks; each peripheral model
+ * watches its block for reads and writes and updates its state the way the
+ * hardware would.
+ *
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+
+// Called before a register of a mapped block is read, to load the value the
+// hardware would return.
+typedef void (*tSimReadHook)(uint32_t ui32Base, uint32_t ui32Offset,
+                             volatile uint32_t *pui32Reg);
+
+// Called once a register of a mapped block has been written with a new
+// value. The hook may change *pui32Reg to what reads back afterwards.
+typedef void (*tSimWriteHook)(uint32_t ui32Base, uint32_t ui32Offset,
+                              uint32_t ui32Value, volatile uint32_t *pui32Reg);
+
+// Register core (sim.c). The access counter counts every HWREG access made
+// since simReset(). The Cortex-M4 cycle counter is mapped by simReset() and
+// runs on the host cycle counter.
+extern uint32_t g_ui32SimAccesses;
+
+extern void simReset(void);
+extern void simMapBlock(uint32_t ui32Base, tSimReadHook pfnRead,
+                        tSimWriteHook pfnWrite);
+extern void simSync(void);
+extern uint32_t simUartOutput(uint8_t *pui8Buffer, uint32_t ui32Size);
+extern void simUartClear(void);
+
+// Flash model (sim_flash.c)
+#define SIM_FLASH_SIZE          0x00040000
+#define SIM_FLASH_PAGE_SIZE     1024
+
+// Assumed worst-case timing of the TM4C123 flash controller. The log rate
+// reported by bench_flashlog scales with these.
+#define SIM_FLASH_ERASE_US      15000
+#define SIM_FLASH_PROGRAM_US    50
+
+extern jmp_buf g_sSimPowerLoss;
+extern uint64_t g_ui64SimFlashTimeUs;
+extern uint32_t g_ui32SimFlashErases;
+extern uint32_t g_ui32SimFlashWords;
+
+extern void simFlashReset(void);
+extern void simFlashFailAfter(int32_t i32Operations);
+extern void simFlashTearAfter(int32_t i32Words);
+extern uint32_t simFlashRead(uint32_t ui32Address);
+extern void simFlashWrite(uint32_t ui32Address, uint32_t ui32Value);
+
+// ADC model (sim_adc.c)
+// Time is counted in sixteenths of a conversion at 1 Msps, the resolution of
+// ADCPhaseDelaySet().
+#define SIM_ADC_TICKS           16
+
+// Passed to the source instead of an AIN number for a differential step,
+// along with the pair number.
+#define SIM_ADC_DIFFERENTIAL    0x100
+
+// Returns the 12-bit value of a channel at a point in time.
+typedef uint32_t (*tSimAdcSource)(uint32_t ui32Base, uint32_t ui32Channel,
+                                  uint64_t ui64Time);
+
+extern uint32_t g_ui32SimAdcConversions;
+
+extern void simAdcReset(tSimAdcSource pfnSource);
+
+// EEPROM model (sim_eeprom.c)
+#define SIM_EEPROM_SIZE         2048
+
+extern uint32_t g_pui32SimEeprom[SIM_EEPROM_SIZE / 4];
+extern uint32_t g_ui32SimEepromInitResult;
+extern bool g_bSimEepromFail;
+
+extern void simEepromReset(void);
+
+// Timer and GPIO model (sim_timer.c)
+// Time is counted in system clock ticks.
+#define SIM_GPIO_TRACE          1024
+
+typedef struct {
+    uint64_t ui64Time;
+    uint8_t ui8Data;
+} tSimGpioEdge;
+
+extern uint64_t g_ui64SimTicks;
+extern tSimGpioEdge g_psSimGpioTrace[SIM_GPIO_TRACE];
+extern uint32_t g_ui32SimGpioEdges;
+
+extern void simTimerReset(void);
+extern void simTimerSetHandler(uint32_t ui32Base, void (*pfnHandler)(void));
+extern void simTimerRun(uint64_t ui64Ticks);
+extern bool simTimerEnabled(uint32_t ui32Base);
+extern uint8_t simGpioData(uint32_t ui32Base);
+
+#endif // __SIM_H__
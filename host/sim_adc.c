@@ -0,0 +1,244 @@
+/* Purpose of the following file is to model the two ADC modules for the host
+ * tests, along with the driverlib ADC calls the firmware makes.
+ *
+ * A processor trigger converts the steps configured with
+ * ADCSequenceStepConfigure() right away and puts the results in the FIFO of
+ * the sequence. While the SYNCWAIT bit of a module's PSSI register is set, a
+ * trigger only arms the sequence; it is started by the next write of GSYNC
+ * to either module, at the same instant as the sequences that write starts.
+ * SYNCWAIT stays set until it is written as zero, as on the hardware.
+ *
+ * The value of each step comes from the source callback, which is passed the
+ * time of the conversion so tests can see when each sample was taken. The
+ * channel is decoded from the step configuration the way the hardware
+ * splits it over the SSMUX, SSEMUX and SSCTL fields.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "driverlib/adc.h"
+#include "sim.h"
+
+#define NUM_SEQUENCES           4
+#define MAX_STEPS               8
+#define SEQ_STRIDE              (ADC_O_SSFIFO1 - ADC_O_SSFIFO0)
+
+// Read back from the write-only registers. No write the firmware makes has
+// all of these bits set.
+#define WRITE_ONLY_IDLE         0x0000FFF0
+
+typedef struct {
+    uint32_t pui32Steps[MAX_STEPS];
+    uint32_t pui32Fifo[MAX_STEPS];
+    uint32_t ui32Head;
+    uint32_t ui32Count;
+    uint32_t ui32Last;
+} tSimSequence;
+
+typedef struct {
+    uint32_t ui32Base;
+    uint32_t ui32Enabled;
+    uint32_t ui32Armed;
+    uint32_t ui32Ris;
+    bool bSyncWait;
+    uint32_t ui32Phase;
+    tSimSequence psSequences[NUM_SEQUENCES];
+} tSimAdc;
+
+static const uint32_t g_pui32FifoDepth[NUM_SEQUENCES] = {8, 4, 4, 1};
+
+static tSimAdc g_psAdc[2];
+static tSimAdcSource g_pfnSource;
+static uint64_t g_ui64Time;
+
+uint32_t g_ui32SimAdcConversions;
+
+static tSimAdc *adcFromBase(uint32_t ui32Base) {
+    return &g_psAdc[ui32Base == ADC1_BASE];
+}
+
+// AIN number selected by an ADCSequenceStepConfigure() value: the low nibble
+// goes to SSMUX, bits 8-11 to SSEMUX, and ADC_CTL_D makes the SSMUX value a
+// differential pair number instead.
+static uint32_t stepChannel(uint32_t ui32Config) {
+    uint32_t mux = ui32Config & 0xF;
+
+    if (ui32Config & ADC_CTL_D) {
+        return SIM_ADC_DIFFERENTIAL | mux;
+    }
+    return (((ui32Config >> 8) & 0xF) << 4) | mux;
+}
+
+static void convert(tSimAdc *psAdc, uint32_t ui32Sequence, uint64_t ui64Start) {
+    tSimSequence *psSeq = &psAdc->psSequences[ui32Sequence];
+
+    if (!(psAdc->ui32Enabled & (1 << ui32Sequence))) {
+        return;
+    }
+    for (uint32_t step = 0; step < g_pui32FifoDepth[ui32Sequence]; step++) {
+        uint32_t config = psSeq->pui32Steps[step];
+        uint64_t time = ui64Start + step * SIM_ADC_TICKS + psAdc->ui32Phase;
+        uint32_t channel = stepChannel(config);
+        uint32_t value = g_pfnSource ?
+                         g_pfnSource(psAdc->ui32Base, channel, time) & 0x0FFF :
+                         0;
+
+        if (psSeq->ui32Count < g_pui32FifoDepth[ui32Sequence]) {
+            psSeq->pui32Fifo[(psSeq->ui32Head + psSeq->ui32Count) %
+                             MAX_STEPS] = value;
+            psSeq->ui32Count++;
+        }
+        g_ui32SimAdcConversions++;
+        if (config & ADC_CTL_IE) {
+            psAdc->ui32Ris |= 1 << ui32Sequence;
+        }
+        if (config & ADC_CTL_END) {
+            break;
+        }
+    }
+}
+
+// Starts the given sequences of a module, and of both modules' armed
+// sequences when bSync is set, all at the current time.
+static void start(tSimAdc *psAdc, uint32_t ui32Sequences, bool bSync) {
+    uint64_t startTime = g_ui64Time;
+
+    for (uint32_t seq = 0; seq < NUM_SEQUENCES; seq++) {
+        if (ui32Sequences & (1 << seq)) {
+            convert(psAdc, seq, startTime);
+        }
+    }
+    if (bSync) {
+        for (uint32_t adc = 0; adc < 2; adc++) {
+            for (uint32_t seq = 0; seq < NUM_SEQUENCES; seq++) {
+                if (g_psAdc[adc].ui32Armed & (1 << seq)) {
+                    convert(&g_psAdc[adc], seq, startTime);
+                }
+            }
+            g_psAdc[adc].ui32Armed = 0;
+        }
+    }
+    g_ui64Time += (MAX_STEPS + 1) * SIM_ADC_TICKS;
+}
+
+static void adcRead(uint32_t ui32Base, uint32_t ui32Offset,
+                    volatile uint32_t *pui32Reg) {
+    tSimAdc *psAdc = adcFromBase(ui32Base);
+    uint32_t seq = (ui32Offset - ADC_O_SSFIFO0) / SEQ_STRIDE;
+
+    if (ui32Offset == ADC_O_ACTSS) {
+        *pui32Reg = psAdc->ui32Enabled;
+    } else if (ui32Offset == ADC_O_RIS) {
+        *pui32Reg = psAdc->ui32Ris;
+    } else if (ui32Offset == ADC_O_ISC) {
+        *pui32Reg = WRITE_ONLY_IDLE;
+    } else if (ui32Offset == ADC_O_PSSI) {
+        *pui32Reg = psAdc->bSyncWait ? ADC_PSSI_SYNCWAIT : 0;
+    } else if (ui32Offset >= ADC_O_SSFIFO0 && seq < NUM_SEQUENCES) {
+        tSimSequence *psSeq = &psAdc->psSequences[seq];
+
+        if (ui32Offset == ADC_O_SSFIFO0 + seq * SEQ_STRIDE) {
+            // Reading the FIFO pops it; an empty FIFO repeats the last value.
+            if (psSeq->ui32Count) {
+                psSeq->ui32Last = psSeq->pui32Fifo[psSeq->ui32Head];
+                psSeq->ui32Head = (psSeq->ui32Head + 1) % MAX_STEPS;
+                psSeq->ui32Count--;
+            }
+            *pui32Reg = psSeq->ui32Last;
+        } else if (ui32Offset == ADC_O_SSFSTAT0 + seq * SEQ_STRIDE) {
+            *pui32Reg = psSeq->ui32Count ? 0 : ADC_SSFSTAT0_EMPTY;
+        }
+    }
+}
+
+static void adcWrite(uint32_t ui32Base, uint32_t ui32Offset,
+                     uint32_t ui32Value, volatile uint32_t *pui32Reg) {
+    tSimAdc *psAdc = adcFromBase(ui32Base);
+
+    if (ui32Offset == ADC_O_ACTSS) {
+        psAdc->ui32Enabled = ui32Value & 0xF;
+    } else if (ui32Offset == ADC_O_ISC) {
+        psAdc->ui32Ris &= ~ui32Value;
+    } else if (ui32Offset == ADC_O_PSSI) {
+        psAdc->bSyncWait = (ui32Value & ADC_PSSI_SYNCWAIT) != 0;
+        if (psAdc->bSyncWait && !(ui32Value & ADC_PSSI_GSYNC)) {
+            psAdc->ui32Armed |= ui32Value & 0xF;
+        } else {
+            start(psAdc, ui32Value & 0xF, (ui32Value & ADC_PSSI_GSYNC) != 0);
+        }
+    }
+}
+
+void simAdcReset(tSimAdcSource pfnSource) {
+    memset(g_psAdc, 0, sizeof(g_psAdc));
+    g_psAdc[0].ui32Base = ADC0_BASE;
+    g_psAdc[1].ui32Base = ADC1_BASE;
+    g_pfnSource = pfnSource;
+    g_ui64Time = 0;
+    g_ui32SimAdcConversions = 0;
+    simMapBlock(ADC0_BASE, adcRead, adcWrite);
+    simMapBlock(ADC1_BASE, adcRead, adcWrite);
+}
+
+//*****************************************************************************
+//
+// driverlib stand-ins. The ones on the sampling path access the registers
+// the same way the TivaWare versions do.
+//
+//*****************************************************************************
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+    HWREG(ui32Base + ADC_O_ACTSS) |= 1 << ui32SequenceNum;
+}
+
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+    HWREG(ui32Base + ADC_O_ACTSS) &= ~(1 << ui32SequenceNum);
+}
+
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                          uint32_t ui32Trigger, uint32_t ui32Priority) {
+}
+
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                              uint32_t ui32Step, uint32_t ui32Config) {
+    adcFromBase(ui32Base)->psSequences[ui32SequenceNum].pui32Steps[ui32Step] =
+        ui32Config;
+}
+
+int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                           uint32_t *pui32Buffer) {
+    uint32_t ui32Count = 0;
+
+    ui32Base += ui32SequenceNum * SEQ_STRIDE;
+    while (!(HWREG(ui32Base + ADC_O_SSFSTAT0) & ADC_SSFSTAT0_EMPTY) &&
+           ui32Count < 8) {
+        *pui32Buffer++ = HWREG(ui32Base + ADC_O_SSFIFO0);
+        ui32Count++;
+    }
+    return ui32Count;
+}
+
+void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+    HWREG(ui32Base + ADC_O_PSSI) |= ((ui32SequenceNum & 0xffff0000) |
+                                     (1 << (ui32SequenceNum & 0xf)));
+}
+
+uint32_t ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                      bool bMasked) {
+    return HWREG(ui32Base + ADC_O_RIS) & (1 << ui32SequenceNum);
+}
+
+void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+    HWREG(ui32Base + ADC_O_ISC) = 1 << ui32SequenceNum;
+}
+
+void ADCPhaseDelaySet(uint32_t ui32Base, uint32_t ui32Phase) {
+    adcFromBase(ui32Base)->ui32Phase = ui32Phase;
+}
+
+void ADCHardwareOversampleConfigure(uint32_t ui32Base, uint32_t ui32Factor) {
+}
@@ -0,0 +1,51 @@
+/* Purpose of the following file is to model the EEPROM for the host tests as
+ * a RAM array, erased to all ones, with injectable failures.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driverlib/eeprom.h"
+#include "sim.h"
+
+uint32_t g_pui32SimEeprom[SIM_EEPROM_SIZE / 4];
+uint32_t g_ui32SimEepromInitResult;
+bool g_bSimEepromFail;
+
+void simEepromReset(void) {
+    memset(g_pui32SimEeprom, 0xFF, sizeof(g_pui32SimEeprom));
+    g_ui32SimEepromInitResult = EEPROM_INIT_OK;
+    g_bSimEepromFail = false;
+}
+
+static void checkRange(uint32_t ui32Address, uint32_t ui32Count) {
+    if ((ui32Address & 3) || (ui32Count & 3) ||
+        ui32Address + ui32Count > SIM_EEPROM_SIZE) {
+        fprintf(stderr, "sim: bad EEPROM access of %u bytes at 0x%x\n",
+                ui32Count, ui32Address);
+        abort();
+    }
+}
+
+uint32_t EEPROMInit(void) {
+    return g_ui32SimEepromInitResult;
+}
+
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address,
+                uint32_t ui32Count) {
+    checkRange(ui32Address, ui32Count);
+    memcpy(pui32Data, &g_pui32SimEeprom[ui32Address / 4], ui32Count);
+}
+
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address,
+                       uint32_t ui32Count) {
+    checkRange(ui32Address, ui32Count);
+    if (g_bSimEepromFail) {
+        return 1;
+    }
+    memcpy(&g_pui32SimEeprom[ui32Address / 4], pui32Data, ui32Count);
+    return 0;
+}
@@ -0,0 +1,109 @@
+/* Purpose of the following file is to model the TM4C123 flash controller for
+ * the host tests.
+ *
+ * Flash is a RAM array that reads back through HWREG like the real memory
+ * map. FlashErase() sets a 1 KB block to ones and FlashProgram() can only
+ * clear bits, as on the hardware. Tests can make a later operation fail, or
+ * cut the power part way through a program: the model then writes only some
+ * of the words and longjmp()s to g_sSimPowerLoss, leaving flash as a reset
+ * would find it.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driverlib/flash.h"
+#include "sim.h"
+
+jmp_buf g_sSimPowerLoss;
+uint64_t g_ui64SimFlashTimeUs;
+uint32_t g_ui32SimFlashErases;
+uint32_t g_ui32SimFlashWords;
+
+static uint32_t g_pui32Flash[SIM_FLASH_SIZE / 4];
+
+// Operations left before the injected failure or power loss, -1 when none is
+// armed.
+static int32_t g_i32FailCountdown = -1;
+static int32_t g_i32TearCountdown = -1;
+
+void simFlashReset(void) {
+    memset(g_pui32Flash, 0xFF, sizeof(g_pui32Flash));
+    g_ui64SimFlashTimeUs = 0;
+    g_ui32SimFlashErases = 0;
+    g_ui32SimFlashWords = 0;
+    g_i32FailCountdown = -1;
+    g_i32TearCountdown = -1;
+}
+
+// The next i32Operations erase or program calls succeed, the one after that
+// returns an error without touching flash.
+void simFlashFailAfter(int32_t i32Operations) {
+    g_i32FailCountdown = i32Operations;
+}
+
+// Power is lost after i32Words more words have been programmed.
+void simFlashTearAfter(int32_t i32Words) {
+    g_i32TearCountdown = i32Words;
+}
+
+uint32_t simFlashRead(uint32_t ui32Address) {
+    return g_pui32Flash[(ui32Address % SIM_FLASH_SIZE) / 4];
+}
+
+// Overwrites a word directly, to build corrupt images the firmware could
+// never produce itself.
+void simFlashWrite(uint32_t ui32Address, uint32_t ui32Value) {
+    g_pui32Flash[(ui32Address % SIM_FLASH_SIZE) / 4] = ui32Value;
+}
+
+volatile uint32_t *simFlashWord(uint32_t ui32Address) {
+    return &g_pui32Flash[ui32Address / 4];
+}
+
+static bool failNow(void) {
+    if (g_i32FailCountdown < 0) {
+        return false;
+    }
+    return g_i32FailCountdown-- == 0;
+}
+
+int32_t FlashErase(uint32_t ui32Address) {
+    if ((ui32Address & (SIM_FLASH_PAGE_SIZE - 1)) ||
+        ui32Address >= SIM_FLASH_SIZE) {
+        fprintf(stderr, "sim: bad erase address 0x%08x\n", ui32Address);
+        abort();
+    }
+    if (failNow()) {
+        return -1;
+    }
+    memset(&g_pui32Flash[ui32Address / 4], 0xFF, SIM_FLASH_PAGE_SIZE);
+    g_ui64SimFlashTimeUs += SIM_FLASH_ERASE_US;
+    g_ui32SimFlashErases++;
+    return 0;
+}
+
+int32_t FlashProgram(uint32_t *pui32Data, uint32_t ui32Address,
+                     uint32_t ui32Count) {
+    if ((ui32Address & 3) || (ui32Count & 3) ||
+        ui32Address + ui32Count > SIM_FLASH_SIZE) {
+        fprintf(stderr, "sim: bad program of %u bytes at 0x%08x\n",
+                ui32Count, ui32Address);
+        abort();
+    }
+    if (failNow()) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < ui32Count / 4; i++) {
+        if (g_i32TearCountdown >= 0 && g_i32TearCountdown-- == 0) {
+            longjmp(g_sSimPowerLoss, 1);
+        }
+        g_pui32Flash[ui32Address / 4 + i] &= pui32Data[i];
+        g_ui64SimFlashTimeUs += SIM_FLASH_PROGRAM_US;
+        g_ui32SimFlashWords++;
+    }
+    return 0;
+}
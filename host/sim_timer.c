@@ -0,0 +1,217 @@
+/* Purpose of the following file is to model the general purpose timers and
+ * the GPIO ports used by the LED for the host tests.
+ *
+ * Timers count system clock ticks as simTimerRun() advances time. A one-shot
+ * timer that reaches zero disables itself, sets its timeout flag and, if the
+ * timeout interrupt is enabled, calls the handler set for it, as the NVIC
+ * would. A periodic timer reloads instead.
+ *
+ * GPIO ports are register blocks: a write to the masked DATA address changes
+ * only the pins in the mask, like the hardware. Every change of the port data
+ * is recorded with the time it happened.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+#include "driverlib/gpio.h"
+#include "driverlib/timer.h"
+#include "sim.h"
+
+#define NUM_TIMERS              3
+#define NUM_PORTS               2
+
+typedef struct {
+    uint32_t ui32Config;
+    uint32_t ui32Load;
+    uint32_t ui32Value;
+    bool bEnabled;
+    bool bIntEnabled;
+    uint32_t ui32Status;
+    void (*pfnHandler)(void);
+} tSimTimer;
+
+static const uint32_t g_pui32PortBases[NUM_PORTS] = {
+    GPIO_PORTA_BASE, GPIO_PORTG_BASE
+};
+
+static tSimTimer g_psTimers[NUM_TIMERS];
+static uint8_t g_pui8PortData[NUM_PORTS];
+
+uint64_t g_ui64SimTicks;
+tSimGpioEdge g_psSimGpioTrace[SIM_GPIO_TRACE];
+uint32_t g_ui32SimGpioEdges;
+
+static tSimTimer *timerFromBase(uint32_t ui32Base) {
+    uint32_t index = (ui32Base - TIMER0_BASE) / 0x1000;
+
+    if (ui32Base < TIMER0_BASE || index >= NUM_TIMERS) {
+        fprintf(stderr, "sim: no timer at 0x%08x\n", ui32Base);
+        abort();
+    }
+    return &g_psTimers[index];
+}
+
+static uint32_t portIndex(uint32_t ui32Base) {
+    for (uint32_t port = 0; port < NUM_PORTS; port++) {
+        if (g_pui32PortBases[port] == ui32Base) {
+            return port;
+        }
+    }
+    abort();
+}
+
+static void gpioRead(uint32_t ui32Base, uint32_t ui32Offset,
+                     volatile uint32_t *pui32Reg) {
+    if (ui32Offset < 0x400) {
+        *pui32Reg = g_pui8PortData[portIndex(ui32Base)] & (ui32Offset >> 2);
+    }
+}
+
+static void gpioWrite(uint32_t ui32Base, uint32_t ui32Offset,
+                      uint32_t ui32Value, volatile uint32_t *pui32Reg) {
+    uint32_t port = portIndex(ui32Base);
+    uint8_t mask = ui32Offset >> 2;
+    uint8_t data = (g_pui8PortData[port] & ~mask) | (ui32Value & mask);
+
+    if (ui32Offset >= 0x400 || data == g_pui8PortData[port]) {
+        return;
+    }
+    g_pui8PortData[port] = data;
+    if (ui32Base == GPIO_PORTG_BASE && g_ui32SimGpioEdges < SIM_GPIO_TRACE) {
+        g_psSimGpioTrace[g_ui32SimGpioEdges].ui64Time = g_ui64SimTicks;
+        g_psSimGpioTrace[g_ui32SimGpioEdges].ui8Data = data;
+        g_ui32SimGpioEdges++;
+    }
+}
+
+// Maps the ports and stops every timer. Handlers stay set.
+void simTimerReset(void) {
+    for (uint32_t timer = 0; timer < NUM_TIMERS; timer++) {
+        void (*pfnHandler)(void) = g_psTimers[timer].pfnHandler;
+        memset(&g_psTimers[timer], 0, sizeof(g_psTimers[timer]));
+        g_psTimers[timer].pfnHandler = pfnHandler;
+    }
+    memset(g_pui8PortData, 0, sizeof(g_pui8PortData));
+    g_ui64SimTicks = 0;
+    g_ui32SimGpioEdges = 0;
+    for (uint32_t port = 0; port < NUM_PORTS; port++) {
+        simMapBlock(g_pui32PortBases[port], gpioRead, gpioWrite);
+    }
+}
+
+void simTimerSetHandler(uint32_t ui32Base, void (*pfnHandler)(void)) {
+    timerFromBase(ui32Base)->pfnHandler = pfnHandler;
+}
+
+bool simTimerEnabled(uint32_t ui32Base) {
+    return timerFromBase(ui32Base)->bEnabled;
+}
+
+uint8_t simGpioData(uint32_t ui32Base) {
+    simSync();
+    return g_pui8PortData[portIndex(ui32Base)];
+}
+
+// Advances time, stopping at every timeout on the way to run its handler.
+void simTimerRun(uint64_t ui64Ticks) {
+    uint64_t end = g_ui64SimTicks + ui64Ticks;
+
+    simSync();
+    while (g_ui64SimTicks < end) {
+        uint64_t step = end - g_ui64SimTicks;
+        tSimTimer *psNext = NULL;
+
+        for (uint32_t timer = 0; timer < NUM_TIMERS; timer++) {
+            tSimTimer *psTimer = &g_psTimers[timer];
+            if (psTimer->bEnabled && psTimer->ui32Value <= step) {
+                step = psTimer->ui32Value;
+                psNext = psTimer;
+            }
+        }
+        for (uint32_t timer = 0; timer < NUM_TIMERS; timer++) {
+            if (g_psTimers[timer].bEnabled) {
+                g_psTimers[timer].ui32Value -= step;
+            }
+        }
+        g_ui64SimTicks += step;
+        if (psNext == NULL) {
+            break;
+        }
+
+        psNext->ui32Status |= TIMER_TIMA_TIMEOUT;
+        if (psNext->ui32Config == TIMER_CFG_ONE_SHOT) {
+            psNext->bEnabled = false;
+        } else {
+            psNext->ui32Value = psNext->ui32Load + 1;
+        }
+        if (psNext->bIntEnabled && psNext->pfnHandler) {
+            psNext->pfnHandler();
+            simSync();
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// driverlib stand-ins.
+//
+//*****************************************************************************
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config) {
+    tSimTimer *psTimer = timerFromBase(ui32Base);
+
+    psTimer->ui32Config = ui32Config;
+    psTimer->bEnabled = false;
+}
+
+// A one-shot timer times out after ui32Value ticks, a periodic one every
+// ui32Value + 1.
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+    tSimTimer *psTimer = timerFromBase(ui32Base);
+
+    psTimer->ui32Load = ui32Value;
+    psTimer->ui32Value = ui32Value;
+}
+
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer) {
+    tSimTimer *psTimer = timerFromBase(ui32Base);
+
+    // A one-shot timer that has run out starts again from its load value.
+    if (!psTimer->bEnabled && psTimer->ui32Value == 0) {
+        psTimer->ui32Value = psTimer->ui32Load;
+    }
+    psTimer->bEnabled = true;
+}
+
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer) {
+    timerFromBase(ui32Base)->bEnabled = false;
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    timerFromBase(ui32Base)->bIntEnabled = true;
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    timerFromBase(ui32Base)->ui32Status &= ~ui32IntFlags;
+}
+
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked) {
+    return timerFromBase(ui32Base)->ui32Status;
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins) {
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val) {
+    HWREG(ui32Port + GPIO_O_DATA + (ui8Pins << 2)) = ui8Val;
+}
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins) {
+    return HWREG(ui32Port + GPIO_O_DATA + (ui8Pins << 2));
+}
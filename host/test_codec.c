@@ -0,0 +1,117 @@
+/* Purpose of the following file is to test that the codec restores every
+ * block exactly, stays within CODEC_MAX_BLOCK_BYTES and rejects malformed
+ * input without reading past it.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codec.h"
+#include "waveforms.h"
+#include "check.h"
+
+#define SAMPLES                 4096
+
+static uint16_t g_pui16Samples[SAMPLES];
+
+static bool roundTrip(const uint16_t *pui16Samples, uint32_t ui32Count) {
+    uint8_t pui8Block[CODEC_MAX_BLOCK_BYTES];
+    uint16_t pui16Decoded[CODEC_BLOCK_SAMPLES];
+    uint32_t length;
+
+    length = codecEncodeBlock(pui16Samples, ui32Count, pui8Block);
+    if (length > CODEC_MAX_BLOCK_BYTES ||
+        !codecDecodeBlock(pui8Block, length, pui16Decoded, ui32Count)) {
+        return false;
+    }
+    return memcmp(pui16Decoded, pui16Samples, ui32Count * 2) == 0;
+}
+
+static void testWaveforms(void) {
+    for (tWaveform wave = 0; wave < WAVE_NUM; wave++) {
+        waveGenerate(wave, g_pui16Samples, SAMPLES);
+        for (uint32_t i = 0; i < SAMPLES; i += CODEC_BLOCK_SAMPLES) {
+            if (!roundTrip(&g_pui16Samples[i], CODEC_BLOCK_SAMPLES)) {
+                printf("%s block %u\n", waveName(wave), i);
+                CHECK(!"round trip failed");
+                break;
+            }
+        }
+    }
+}
+
+// Partial blocks, as written by flashLogFlush(), of every length.
+static void testBlockLengths(void) {
+    waveGenerate(WAVE_NOISY_SINE, g_pui16Samples, SAMPLES);
+    for (uint32_t count = 1; count <= CODEC_BLOCK_SAMPLES; count++) {
+        CHECK(roundTrip(g_pui16Samples, count));
+    }
+}
+
+// One huge step in an otherwise flat block makes the Rice quotient far wider
+// than a word.
+static void testOutliers(void) {
+    uint16_t pui16Block[CODEC_BLOCK_SAMPLES];
+
+    for (uint32_t position = 1; position < CODEC_BLOCK_SAMPLES; position++) {
+        for (uint32_t i = 0; i < CODEC_BLOCK_SAMPLES; i++) {
+            pui16Block[i] = i < position ? 0 : 4095;
+        }
+        CHECK(roundTrip(pui16Block, CODEC_BLOCK_SAMPLES));
+    }
+}
+
+// Only the low 12 bits of a sample are coded.
+static void testHighBitsIgnored(void) {
+    uint16_t pui16Block[2] = {0xF123, 0x0456};
+    uint16_t pui16Decoded[2];
+    uint8_t pui8Block[CODEC_MAX_BLOCK_BYTES];
+    uint32_t length = codecEncodeBlock(pui16Block, 2, pui8Block);
+
+    CHECK(codecDecodeBlock(pui8Block, length, pui16Decoded, 2));
+    CHECK(pui16Decoded[0] == 0x0123 && pui16Decoded[1] == 0x0456);
+}
+
+static void testMalformed(void) {
+    uint8_t pui8Block[CODEC_MAX_BLOCK_BYTES];
+    uint16_t pui16Decoded[CODEC_BLOCK_SAMPLES];
+    uint32_t length, seed = 7;
+
+    waveGenerate(WAVE_NOISE, g_pui16Samples, CODEC_BLOCK_SAMPLES);
+    length = codecEncodeBlock(g_pui16Samples, CODEC_BLOCK_SAMPLES, pui8Block);
+
+    // Every truncation is caught.
+    for (uint32_t bytes = 0; bytes < length; bytes++) {
+        CHECK(!codecDecodeBlock(pui8Block, bytes, pui16Decoded,
+                                CODEC_BLOCK_SAMPLES));
+    }
+    CHECK(!codecDecodeBlock(pui8Block, length, pui16Decoded, 0));
+    CHECK(!codecDecodeBlock(pui8Block, length, pui16Decoded,
+                            CODEC_BLOCK_SAMPLES + 1));
+
+    // Random bytes may decode to something, but never out of range and
+    // never past the buffer (the sanitizers check the latter).
+    for (uint32_t trial = 0; trial < 10000; trial++) {
+        for (uint32_t i = 0; i < sizeof(pui8Block); i++) {
+            seed = seed * 1103515245 + 12345;
+            pui8Block[i] = seed >> 16;
+        }
+        if (codecDecodeBlock(pui8Block, sizeof(pui8Block), pui16Decoded,
+                             CODEC_BLOCK_SAMPLES)) {
+            for (uint32_t i = 0; i < CODEC_BLOCK_SAMPLES; i++) {
+                CHECK(pui16Decoded[i] <= 0x0FFF);
+            }
+        }
+    }
+}
+
+int main(void) {
+    testWaveforms();
+    testBlockLengths();
+    testOutliers();
+    testHighBitsIgnored();
+    testMalformed();
+    return CHECK_DONE();
+}
@@ -0,0 +1,199 @@
+/* Purpose of the following file is to test the configuration store: every
+ * setting through the terminal commands and back out of the EEPROM record,
+ * range checks, and recovery from a missing or damaged record.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+#include "sim.h"
+#include "check.h"
+
+#define CONFIG_MAGIC            0x34474643
+
+typedef struct {
+    const char *pcName;
+    tConfigItem eItem;
+    uint32_t ui32Valid;         // Valid and not the default
+    uint32_t ui32Invalid;       // Out of range, 0 if the range has no gap
+} tSetting;
+
+static const tSetting g_psSettings[] = {
+    { "rate",     CONFIG_SAMPLE_RATE,   2500,     100001 },
+    { "channels", CONFIG_CHANNEL_MASK,  0x00F00F, 0 },
+    { "avg",      CONFIG_AVERAGING,     16,       128 },
+    { "format",   CONFIG_OUTPUT_FORMAT, 2,        3 },
+    { "display",  CONFIG_DISPLAY_RATE,  30,       61 },
+    { "mode",     CONFIG_ACQUIRE_MODE,  1,        3 },
+    { "view",     CONFIG_DISPLAY_VIEW,  1,        2 },
+    { "filter",   CONFIG_FILTER,        3,        5 },
+    { "cutoff",   CONFIG_CUTOFF,        60,       50001 },
+    { "ledduty",  CONFIG_LED_DUTY,      40,       101 },
+    { "ledperiod", CONFIG_LED_PERIOD,   250,      10001 },
+};
+
+#define NUM_SETTINGS    (sizeof(g_psSettings) / sizeof(g_psSettings[0]))
+
+static char g_pcReply[256];
+
+// Same as checksum() in config.c, over the record in the EEPROM model.
+static uint32_t recordChecksum(void) {
+    uint32_t sum = CONFIG_MAGIC;
+    for (uint32_t item = 0; item < CONFIG_NUM_ITEMS; item++) {
+        sum = (sum << 1 | sum >> 31) ^ g_pui32SimEeprom[1 + item];
+    }
+    return sum;
+}
+
+static int32_t command(const char *pcFormat, const char *pcName,
+                       uint32_t ui32Value) {
+    char pcLine[32];
+
+    snprintf(pcLine, sizeof(pcLine), pcFormat, pcName, ui32Value);
+    return configCommand(pcLine, g_pcReply, sizeof(g_pcReply));
+}
+
+static void boot(void) {
+    simReset();
+    configInit();
+}
+
+static void testRoundTrip(void) {
+    uint32_t pui32Defaults[CONFIG_NUM_ITEMS];
+    char pcExpected[32];
+
+    CHECK(NUM_SETTINGS == CONFIG_NUM_ITEMS);
+
+    // Blank EEPROM: defaults.
+    simEepromReset();
+    boot();
+    for (uint32_t item = 0; item < CONFIG_NUM_ITEMS; item++) {
+        pui32Defaults[item] = configGet((tConfigItem)item);
+    }
+
+    for (uint32_t i = 0; i < NUM_SETTINGS; i++) {
+        const tSetting *psSetting = &g_psSettings[i];
+
+        CHECK(psSetting->ui32Valid != pui32Defaults[psSetting->eItem]);
+        CHECK(command("set %s %u", psSetting->pcName, psSetting->ui32Valid) ==
+              (int32_t)psSetting->eItem);
+        snprintf(pcExpected, sizeof(pcExpected), "%s=%u", psSetting->pcName,
+                 psSetting->ui32Valid);
+        CHECK(strcmp(g_pcReply, pcExpected) == 0);
+        CHECK(command("get %s", psSetting->pcName, 0) == CONFIG_NONE);
+        CHECK(strcmp(g_pcReply, pcExpected) == 0);
+        CHECK(configGet(psSetting->eItem) == psSetting->ui32Valid);
+    }
+
+    // Not saved yet: a reset brings back the defaults.
+    boot();
+    for (uint32_t i = 0; i < NUM_SETTINGS; i++) {
+        CHECK(configGet(g_psSettings[i].eItem) ==
+              pui32Defaults[g_psSettings[i].eItem]);
+        command("set %s %u", g_psSettings[i].pcName, g_psSettings[i].ui32Valid);
+    }
+    CHECK(command("save", "", 0) == CONFIG_NONE);
+    CHECK(strcmp(g_pcReply, "OK") == 0);
+    CHECK(g_pui32SimEeprom[0] == CONFIG_MAGIC);
+    CHECK(g_pui32SimEeprom[CONFIG_NUM_ITEMS + 1] == recordChecksum());
+
+    // Saved: every value survives a reset.
+    boot();
+    for (uint32_t i = 0; i < NUM_SETTINGS; i++) {
+        CHECK(configGet(g_psSettings[i].eItem) == g_psSettings[i].ui32Valid);
+        CHECK(g_pui32SimEeprom[1 + g_psSettings[i].eItem] ==
+              g_psSettings[i].ui32Valid);
+    }
+
+    // "list" shows every setting.
+    command("list", "", 0);
+    for (uint32_t i = 0; i < NUM_SETTINGS; i++) {
+        snprintf(pcExpected, sizeof(pcExpected), "%s=%u",
+                 g_psSettings[i].pcName, g_psSettings[i].ui32Valid);
+        CHECK(strstr(g_pcReply, pcExpected) != NULL);
+    }
+
+    // "defaults" changes everything in RAM only.
+    CHECK(command("defaults", "", 0) == CONFIG_ALL);
+    CHECK(configGet(CONFIG_SAMPLE_RATE) == pui32Defaults[CONFIG_SAMPLE_RATE]);
+    boot();
+    CHECK(configGet(CONFIG_SAMPLE_RATE) == 2500);
+}
+
+static void testRejected(void) {
+    simEepromReset();
+    boot();
+
+    for (uint32_t i = 0; i < NUM_SETTINGS; i++) {
+        const tSetting *psSetting = &g_psSettings[i];
+        uint32_t before = configGet(psSetting->eItem);
+
+        if (psSetting->ui32Invalid == 0) {
+            continue;
+        }
+        CHECK(command("set %s %u", psSetting->pcName, psSetting->ui32Invalid) ==
+              CONFIG_NONE);
+        CHECK(strcmp(g_pcReply, "ERR range") == 0);
+        CHECK(configGet(psSetting->eItem) == before);
+    }
+
+    // Averaging must be a power of two.
+    CHECK(!configSet(CONFIG_AVERAGING, 3));
+    CHECK(configSet(CONFIG_AVERAGING, 64));
+
+    // At most 8 channels, one per step of the sequence.
+    CHECK(!configSet(CONFIG_CHANNEL_MASK, 0));
+    CHECK(!configSet(CONFIG_CHANNEL_MASK, 0x1FF));
+    CHECK(!configSet(CONFIG_CHANNEL_MASK, 0xFFFFFF));
+    CHECK(!configSet(CONFIG_CHANNEL_MASK, 0x1000000));
+    CHECK(configSet(CONFIG_CHANNEL_MASK, 0xFF));
+    CHECK(configSet(CONFIG_CHANNEL_MASK, 0xFF0000));
+    CHECK(configSet(CONFIG_CHANNEL_MASK, 0x800001));
+
+    CHECK(command("set bogus %u", "", 1) == CONFIG_NONE);
+    CHECK(strcmp(g_pcReply, "ERR name") == 0);
+    CHECK(command("set %s", "rate", 0) == CONFIG_NONE);
+    CHECK(strcmp(g_pcReply, "ERR command") == 0);
+    CHECK(command("frob %s", "rate", 0) == CONFIG_NONE);
+    CHECK(strcmp(g_pcReply, "ERR command") == 0);
+    CHECK(command("", "", 0) == CONFIG_NONE);
+}
+
+static void testDamagedRecord(void) {
+    // A flipped bit fails the checksum.
+    simEepromReset();
+    boot();
+    configSet(CONFIG_SAMPLE_RATE, 2500);
+    CHECK(configSave());
+    g_pui32SimEeprom[1] ^= 0x100;
+    boot();
+    CHECK(configGet(CONFIG_SAMPLE_RATE) == 0);
+
+    // A record with a good checksum but a value out of range, as an older
+    // firmware with wider limits could have saved.
+    configSet(CONFIG_CHANNEL_MASK, 0xFF);
+    CHECK(configSave());
+    g_pui32SimEeprom[1 + CONFIG_CHANNEL_MASK] = 0x1FF;
+    g_pui32SimEeprom[CONFIG_NUM_ITEMS + 1] = recordChecksum();
+    boot();
+    CHECK(configGet(CONFIG_CHANNEL_MASK) == 1 << 7);
+
+    // EEPROM failures.
+    g_ui32SimEepromInitResult = 1;
+    boot();
+    CHECK(configGet(CONFIG_CHANNEL_MASK) == 1 << 7);
+    g_ui32SimEepromInitResult = 0;
+    g_bSimEepromFail = true;
+    CHECK(command("save", "", 0) == CONFIG_NONE);
+    CHECK(strcmp(g_pcReply, "ERR eeprom") == 0);
+}
+
+int main(void) {
+    testRoundTrip();
+    testRejected();
+    testDamagedRecord();
+    return CHECK_DONE();
+}
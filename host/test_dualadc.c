@@ -0,0 +1,146 @@
+/* Purpose of the following file is to test that the dual ADC mode returns
+ * samples in the order they were taken, against the ADC model.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "driverlib/adc.h"
+#include "dualadc.h"
+#include "config.h"
+#include "sim.h"
+#include "check.h"
+
+// Each sample records when and where it was taken: the channel in the top
+// bits and the time in half conversions below.
+static uint32_t timeSource(uint32_t ui32Base, uint32_t ui32Channel,
+                           uint64_t ui64Time) {
+    return (ui32Channel << 9) | ((ui64Time / (SIM_ADC_TICKS / 2)) & 0x1FF);
+}
+
+static void testMerge(void) {
+    uint32_t pui32A[DUALADC_STEPS] = {10, 11, 12, 13, 14, 15, 16, 17};
+    uint32_t pui32B[DUALADC_STEPS] = {20, 21, 22, 23, 24, 25, 26, 27};
+    uint32_t pui32Out[DUALADC_MAX_SAMPLES];
+    uint32_t count;
+
+    // Full FIFOs alternate, ADC0 first.
+    count = dualAdcMerge(pui32A, 8, pui32B, 8, pui32Out);
+    CHECK(count == 16);
+    for (uint32_t i = 0; i < 8; i++) {
+        CHECK(pui32Out[2 * i] == pui32A[i] && pui32Out[2 * i + 1] == pui32B[i]);
+    }
+
+    // Unequal counts: pairs while both have samples, then the rest of the
+    // longer FIFO in order.
+    count = dualAdcMerge(pui32A, 8, pui32B, 5, pui32Out);
+    CHECK(count == 13);
+    CHECK(pui32Out[8] == 14 && pui32Out[9] == 24);
+    CHECK(pui32Out[10] == 15 && pui32Out[11] == 16 && pui32Out[12] == 17);
+
+    count = dualAdcMerge(pui32A, 3, pui32B, 8, pui32Out);
+    CHECK(count == 11);
+    CHECK(pui32Out[4] == 12 && pui32Out[5] == 22);
+    CHECK(pui32Out[6] == 23 && pui32Out[10] == 27);
+
+    CHECK(dualAdcMerge(pui32A, 0, pui32B, 2, pui32Out) == 2);
+    CHECK(pui32Out[0] == 20 && pui32Out[1] == 21);
+    CHECK(dualAdcMerge(pui32A, 0, pui32B, 0, pui32Out) == 0);
+}
+
+// Interleaved: one channel, every sample half a conversion after the last.
+static void testInterleaved(void) {
+    uint32_t pui32Out[DUALADC_MAX_SAMPLES];
+
+    simReset();
+    simAdcReset(timeSource);
+    dualAdcInit(DUALADC_INTERLEAVED, ADC_CTL_CH6, ADC_CTL_CH7);
+    for (uint32_t read = 0; read < 3; read++) {
+        CHECK(dualAdcRead(pui32Out) == DUALADC_MAX_SAMPLES);
+        for (uint32_t i = 0; i < DUALADC_MAX_SAMPLES; i++) {
+            CHECK(pui32Out[i] >> 9 == 6);
+            if (i > 0) {
+                CHECK((pui32Out[i] & 0x1FF) == (pui32Out[i - 1] & 0x1FF) + 1);
+            }
+        }
+    }
+}
+
+// Simultaneous: pairs of ADC0 then ADC1 taken at the same instant, one
+// conversion apart.
+static void testSimultaneous(void) {
+    uint32_t pui32Out[DUALADC_MAX_SAMPLES];
+
+    simReset();
+    simAdcReset(timeSource);
+    dualAdcInit(DUALADC_SIMULTANEOUS, ADC_CTL_CH5, ADC_CTL_CH7);
+    CHECK(dualAdcRead(pui32Out) == DUALADC_MAX_SAMPLES);
+    for (uint32_t i = 0; i < DUALADC_MAX_SAMPLES; i += 2) {
+        CHECK(pui32Out[i] >> 9 == 5 && pui32Out[i + 1] >> 9 == 7);
+        CHECK((pui32Out[i] & 0x1FF) == (pui32Out[i + 1] & 0x1FF));
+        if (i > 0) {
+            CHECK((pui32Out[i] & 0x1FF) == (pui32Out[i - 2] & 0x1FF) + 2);
+        }
+    }
+}
+
+// Returns the channel number the step selected.
+static uint32_t channelSource(uint32_t ui32Base, uint32_t ui32Channel,
+                              uint64_t ui64Time) {
+    return ui32Channel;
+}
+
+// Channels 16-23 from the "channels" setting reach the ADC as AIN16-23, not
+// as differential pairs.
+static void testHighChannels(void) {
+    static const uint32_t pui32Masks[][3] = {
+        // mask, first channel, second channel
+        { 0x800001, 0, 23 },
+        { 0x810000, 16, 23 },
+        { 0x008100, 8, 15 },
+    };
+    uint32_t pui32Channels[2], pui32Out[DUALADC_MAX_SAMPLES];
+
+    for (uint32_t i = 0; i < sizeof(pui32Masks) / sizeof(pui32Masks[0]); i++) {
+        simReset();
+        simAdcReset(channelSource);
+        CHECK(configSet(CONFIG_CHANNEL_MASK, pui32Masks[i][0]));
+        CHECK(configChannels(pui32Channels, 2) == 2);
+        dualAdcInit(DUALADC_SIMULTANEOUS, pui32Channels[0], pui32Channels[1]);
+        CHECK(dualAdcRead(pui32Out) == DUALADC_MAX_SAMPLES);
+        CHECK(pui32Out[0] == pui32Masks[i][1]);
+        CHECK(pui32Out[1] == pui32Masks[i][2]);
+    }
+}
+
+// A dual read leaves SYNCWAIT set on ADC0, so a plain trigger afterwards
+// only arms the sequence until it is cleared, which configureADC0() does.
+static void testSyncWaitLeftSet(void) {
+    uint32_t pui32Out[DUALADC_MAX_SAMPLES];
+
+    simReset();
+    simAdcReset(timeSource);
+    dualAdcInit(DUALADC_SIMULTANEOUS, ADC_CTL_CH5, ADC_CTL_CH7);
+    dualAdcRead(pui32Out);
+    CHECK(HWREG(ADC0_BASE + ADC_O_PSSI) & ADC_PSSI_SYNCWAIT);
+
+    ADCProcessorTrigger(ADC0_BASE, 0);
+    CHECK(!ADCIntStatus(ADC0_BASE, 0, false));
+
+    HWREG(ADC0_BASE + ADC_O_PSSI) &= ~ADC_PSSI_SYNCWAIT;
+    ADCProcessorTrigger(ADC0_BASE, 0);
+    CHECK(ADCIntStatus(ADC0_BASE, 0, false));
+    CHECK(ADCSequenceDataGet(ADC0_BASE, 0, pui32Out) == DUALADC_STEPS);
+}
+
+int main(void) {
+    testMerge();
+    testInterleaved();
+    testSimultaneous();
+    testSyncWaitLeftSet();
+    testHighChannels();
+    return CHECK_DONE();
+}
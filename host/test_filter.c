@@ -0,0 +1,214 @@
+/* Purpose of the following file is to test the filters against double
+ * precision references: the magnitude response of every type measured by
+ * running sines through the single precision code, the output level of the
+ * firmware chain, and that block and single-sample processing agree.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+#include "filter.h"
+#include "check.h"
+
+#define PI                      3.14159265358979323846
+#define SAMPLE_RATE             10000.0
+#define CUTOFF                  500.0
+#define SETTLE                  10000
+#define MEASURE                 20000
+
+// Reference magnitude at f Hz. A digital Butterworth from the bilinear
+// transform has |H|^2 = 1 / (1 + (tan(w/2) / tan(wc/2))^2n), the notch and
+// FIR are evaluated from coefficients designed in double precision.
+static double reference(uint32_t ui32Type, double dFrequency) {
+    double w = 2 * PI * dFrequency / SAMPLE_RATE;
+    double wc = 2 * PI * CUTOFF / SAMPLE_RATE;
+    double ratio = tan(w / 2) / tan(wc / 2);
+
+    switch (ui32Type) {
+    case FILTER_LOWPASS:
+        return 1 / sqrt(1 + pow(ratio, 8));
+    case FILTER_HIGHPASS:
+        return 1 / sqrt(1 + pow(1 / ratio, 8));
+    case FILTER_NOTCH: {
+        double alpha = sin(wc) / (2 * 5.0);
+        double complex z1 = cexp(-I * w);
+        double complex b = 1 - 2 * cos(wc) * z1 + z1 * z1;
+        double complex a = (1 + alpha) - 2 * cos(wc) * z1 +
+                           (1 - alpha) * z1 * z1;
+        return cabs(b / a);
+    }
+    case FILTER_FIR_LOWPASS: {
+        double complex h = 0;
+        double sum = 0;
+        for (int tap = 0; tap < 15; tap++) {
+            double n = tap - 7.0;
+            double tapValue = (n == 0 ? wc / PI : sin(wc * n) / (PI * n)) *
+                              (0.54 - 0.46 * cos(2 * PI * tap / 14));
+            h += tapValue * cexp(-I * w * tap);
+            sum += tapValue;
+        }
+        return cabs(h) / sum;
+    }
+    default:
+        return 1;
+    }
+}
+
+// Runs a unit sine through the filter and fits a sine at the same frequency
+// to the settled output.
+static double measure(const tFilterDesign *psDesign, double dFrequency) {
+    static float pfBuffer[SETTLE + MEASURE];
+    tFilterState sState;
+    double inPhase = 0, quadrature = 0;
+
+    for (uint32_t i = 0; i < SETTLE + MEASURE; i++) {
+        pfBuffer[i] = (float)sin(2 * PI * dFrequency * i / SAMPLE_RATE);
+    }
+    filterReset(psDesign, &sState, 0.0f);
+    filterProcess(psDesign, &sState, pfBuffer, pfBuffer, SETTLE + MEASURE);
+    for (uint32_t i = SETTLE; i < SETTLE + MEASURE; i++) {
+        double phase = 2 * PI * dFrequency * i / SAMPLE_RATE;
+        inPhase += pfBuffer[i] * sin(phase);
+        quadrature += pfBuffer[i] * cos(phase);
+    }
+    return 2 * sqrt(inPhase * inPhase + quadrature * quadrature) / MEASURE;
+}
+
+static void testResponse(void) {
+    static const double pdFrequencies[] = {
+        20, 100, 250, 400, 450, 500, 550, 600, 750, 1000, 2000, 4000, 4900
+    };
+    static const char *ppcNames[] = { "", "lowpass", "highpass", "notch",
+                                      "fir" };
+
+    for (uint32_t type = FILTER_LOWPASS; type <= FILTER_FIR_LOWPASS; type++) {
+        tFilterDesign sDesign;
+        double worst = 0;
+
+        filterDesign(&sDesign, type, SAMPLE_RATE, CUTOFF);
+        for (uint32_t i = 0; i < sizeof(pdFrequencies) / sizeof(double); i++) {
+            double expected = reference(type, pdFrequencies[i]);
+            double error = fabs(measure(&sDesign, pdFrequencies[i]) -
+                                expected);
+
+            // 0.1% of the gain, or -80 dB in the stop band.
+            if (error > 0.001 * expected + 1e-4) {
+                printf("%s at %.0f Hz: %f, expected %f\n", ppcNames[type],
+                       pdFrequencies[i], expected + error, expected);
+                CHECK(!"response differs from the reference");
+            }
+            worst = error > worst ? error : worst;
+        }
+        printf("%-9s largest error %.2e\n", ppcNames[type], worst);
+    }
+}
+
+// Peak to peak and mean of the chain output for a sine on a DC level.
+static void chainOutput(uint32_t ui32Type, double dLevel, double dAmplitude,
+                        double dFrequency, uint32_t *pui32Min,
+                        uint32_t *pui32Max, double *pdMean) {
+    double sum = 0;
+
+    filterChainConfigure(ui32Type, SAMPLE_RATE, CUTOFF);
+    *pui32Min = 4095;
+    *pui32Max = 0;
+    for (uint32_t i = 0; i < SETTLE + MEASURE; i++) {
+        uint32_t out = filterChainSample(0, (uint32_t)(dLevel + dAmplitude *
+                       sin(2 * PI * dFrequency * i / SAMPLE_RATE) + 0.5));
+        if (i >= SETTLE) {
+            *pui32Min = out < *pui32Min ? out : *pui32Min;
+            *pui32Max = out > *pui32Max ? out : *pui32Max;
+            sum += out;
+        }
+    }
+    *pdMean = sum / MEASURE;
+}
+
+static void testChainLevel(void) {
+    uint32_t min, max;
+    double mean;
+
+    // High-pass: a sine on any DC level comes out whole around mid-scale.
+    chainOutput(FILTER_HIGHPASS, 700, 400, 2000, &min, &max, &mean);
+    CHECK(fabs(mean - 2048) < 2);
+    CHECK(min < 1700 && min > 1600 && max > 2400 && max < 2500);
+
+    // The first sample already reads mid-scale, with no step to settle.
+    filterChainConfigure(FILTER_HIGHPASS, SAMPLE_RATE, CUTOFF);
+    CHECK(filterChainSample(0, 3000) == 2048);
+
+    // Notch and low-pass keep the input's DC level.
+    chainOutput(FILTER_NOTCH, 700, 400, 2000, &min, &max, &mean);
+    CHECK(fabs(mean - 700) < 2);
+    CHECK(min < 350 && max > 1050);
+    chainOutput(FILTER_NOTCH, 700, 400, CUTOFF, &min, &max, &mean);
+    CHECK(min > 690 && max < 710);
+    chainOutput(FILTER_LOWPASS, 3000, 400, 50, &min, &max, &mean);
+    CHECK(fabs(mean - 3000) < 2 && min < 2610 && max > 3390);
+
+    // Full-scale steps swing the high-pass output twice as far: clipped, not
+    // wrapped, at the ends of the range.
+    filterChainConfigure(FILTER_HIGHPASS, SAMPLE_RATE, CUTOFF);
+    min = 4095;
+    max = 0;
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t out = filterChainSample(0, (i / 100) & 1 ? 4095 : 0);
+        min = out < min ? out : min;
+        max = out > max ? out : max;
+    }
+    CHECK(min == 0 && max == 4095);
+}
+
+// One block gives bit-identical results to the same samples one at a time,
+// and channels do not affect each other.
+static void testBlockEquivalence(void) {
+    float pfBlock[256], pfSingle[256];
+
+    for (uint32_t type = FILTER_LOWPASS; type <= FILTER_FIR_LOWPASS; type++) {
+        tFilterDesign sDesign;
+        tFilterState sBlock, sSingle;
+
+        for (uint32_t i = 0; i < 256; i++) {
+            pfBlock[i] = pfSingle[i] = (float)(2048 + 1000 * sin(i * 0.3) +
+                                               (i % 7) * 13);
+        }
+        filterDesign(&sDesign, type, SAMPLE_RATE, CUTOFF);
+        filterReset(&sDesign, &sBlock, pfBlock[0]);
+        filterReset(&sDesign, &sSingle, pfSingle[0]);
+        filterProcess(&sDesign, &sBlock, pfBlock, pfBlock, 256);
+        for (uint32_t i = 0; i < 256; i++) {
+            filterProcess(&sDesign, &sSingle, &pfSingle[i], &pfSingle[i], 1);
+        }
+        CHECK(memcmp(pfBlock, pfSingle, sizeof(pfBlock)) == 0);
+    }
+
+    filterChainConfigure(FILTER_LOWPASS, SAMPLE_RATE, CUTOFF);
+    {
+        uint32_t pui32Alone[200], pui32Mixed[200];
+
+        for (uint32_t i = 0; i < 200; i++) {
+            pui32Alone[i] = filterChainSample(1, 2048 + (i * 37) % 1000);
+        }
+        filterChainConfigure(FILTER_LOWPASS, SAMPLE_RATE, CUTOFF);
+        for (uint32_t i = 0; i < 200; i++) {
+            filterChainSample(0, 100);
+            pui32Mixed[i] = filterChainSample(1, 2048 + (i * 37) % 1000);
+            filterChainSample(2, 4000);
+        }
+        CHECK(memcmp(pui32Alone, pui32Mixed, sizeof(pui32Alone)) == 0);
+    }
+
+    // No sample rate, no filter.
+    filterChainConfigure(FILTER_LOWPASS, 0.0f, CUTOFF);
+    CHECK(filterChainSample(0, 1234) == 1234);
+}
+
+int main(void) {
+    testResponse();
+    testChainLevel();
+    testBlockEquivalence();
+    return CHECK_DONE();
+}
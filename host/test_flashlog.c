@@ -0,0 +1,300 @@
+/* Purpose of the following file is to test the flash log against the flash
+ * model: finding the newest page and the end of its records after a reset,
+ * wrap-around of the page ring and of the sequence number, failed flash
+ * operations and power lost part way through a write.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flashlog.h"
+#include "codec.h"
+#include "sim.h"
+#include "check.h"
+
+#define PAGE_MAGIC              0x474F4C46
+#define RECORD_TAG              0xA5000000
+#define MAX_SAMPLES             (FLASHLOG_NUM_PAGES * FLASHLOG_PAGE_SIZE)
+
+static uint16_t g_pui16Samples[4 * MAX_SAMPLES];
+static uint16_t g_pui16Read[MAX_SAMPLES];
+
+// Noisy samples around mid-scale, so a page holds about a dozen blocks.
+static void makeSamples(void) {
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < sizeof(g_pui16Samples) / 2; i++) {
+        seed = seed * 1103515245 + 12345;
+        g_pui16Samples[i] = 1920 + ((seed >> 16) & 0xFF);
+    }
+}
+
+static void reboot(void) {
+    simReset();
+    flashLogInit();
+}
+
+// Decodes the log independently of flashlog.c: pages in sequence order, the
+// records of each page up to the first one that is not committed.
+static uint32_t readLog(uint16_t *pui16Out) {
+    uint32_t pui32Order[FLASHLOG_NUM_PAGES];
+    uint32_t pages = 0, count = 0;
+
+    for (uint32_t page = 0; page < FLASHLOG_NUM_PAGES; page++) {
+        uint32_t address = FLASHLOG_BASE + page * FLASHLOG_PAGE_SIZE;
+        uint32_t i;
+
+        if (simFlashRead(address) != PAGE_MAGIC) {
+            continue;
+        }
+        // Insertion sort on the signed sequence difference.
+        for (i = pages; i > 0; i--) {
+            uint32_t other = FLASHLOG_BASE + pui32Order[i - 1] *
+                             FLASHLOG_PAGE_SIZE;
+            if ((int32_t)(simFlashRead(address + 4) -
+                          simFlashRead(other + 4)) > 0) {
+                break;
+            }
+            pui32Order[i] = pui32Order[i - 1];
+        }
+        pui32Order[i] = page;
+        pages++;
+    }
+
+    for (uint32_t i = 0; i < pages; i++) {
+        uint32_t address = FLASHLOG_BASE + pui32Order[i] * FLASHLOG_PAGE_SIZE;
+        uint32_t offset = 8;
+
+        while (offset + 4 <= FLASHLOG_PAGE_SIZE) {
+            uint32_t header = simFlashRead(address + offset);
+            uint32_t length = header & 0xFFFF;
+            uint32_t samples = (header >> 16) & 0xFF;
+            uint8_t pui8Payload[CODEC_MAX_BLOCK_BYTES];
+
+            if ((header & 0xFF000000) != RECORD_TAG) {
+                break;
+            }
+            CHECK(length <= CODEC_MAX_BLOCK_BYTES);
+            CHECK(offset + 4 + length <= FLASHLOG_PAGE_SIZE);
+            for (uint32_t byte = 0; byte < length; byte++) {
+                uint32_t word = simFlashRead(address + offset + 4 +
+                                             (byte & ~3));
+                pui8Payload[byte] = word >> (8 * (byte & 3));
+            }
+            CHECK(count + samples <= MAX_SAMPLES);
+            CHECK(codecDecodeBlock(pui8Payload, length, pui16Out + count,
+                                   samples));
+            count += samples;
+            offset += 4 + ((length + 3) & ~3);
+        }
+    }
+    return count;
+}
+
+static bool logMatches(uint32_t ui32First, uint32_t ui32Count) {
+    if (readLog(g_pui16Read) != ui32Count) {
+        return false;
+    }
+    return memcmp(g_pui16Read, &g_pui16Samples[ui32First],
+                  ui32Count * 2) == 0;
+}
+
+static bool logSamples(uint32_t ui32First, uint32_t ui32Count) {
+    bool ok = true;
+
+    for (uint32_t i = ui32First; i < ui32First + ui32Count; i++) {
+        ok &= flashLogSample(g_pui16Samples[i]);
+    }
+    return ok;
+}
+
+static void testFreshAndResume(void) {
+    simFlashReset();
+    reboot();
+    CHECK(simFlashRead(FLASHLOG_BASE) == PAGE_MAGIC);
+    CHECK(simFlashRead(FLASHLOG_BASE + 4) == 1);
+    CHECK(readLog(g_pui16Read) == 0);
+
+    CHECK(logSamples(0, 10 * FLASHLOG_BLOCK_SAMPLES));
+    CHECK(logMatches(0, 10 * FLASHLOG_BLOCK_SAMPLES));
+
+    // A partial block is only written by an explicit flush.
+    CHECK(logSamples(10 * FLASHLOG_BLOCK_SAMPLES, 10));
+    CHECK(logMatches(0, 10 * FLASHLOG_BLOCK_SAMPLES));
+    CHECK(flashLogFlush());
+    CHECK(logMatches(0, 10 * FLASHLOG_BLOCK_SAMPLES + 10));
+
+    // After a reset logging carries on behind the last record.
+    reboot();
+    CHECK(logSamples(10 * FLASHLOG_BLOCK_SAMPLES + 10,
+                     30 * FLASHLOG_BLOCK_SAMPLES));
+    CHECK(logMatches(0, 40 * FLASHLOG_BLOCK_SAMPLES + 10));
+}
+
+static void testWrapAround(void) {
+    uint32_t total = 3 * MAX_SAMPLES / 2, count;
+
+    simFlashReset();
+    reboot();
+    CHECK(logSamples(0, total));
+
+    // Only the newest pages are kept, and they end with the last block.
+    count = readLog(g_pui16Read);
+    CHECK(count > (FLASHLOG_NUM_PAGES - 2) * 10 * FLASHLOG_BLOCK_SAMPLES);
+    CHECK(memcmp(g_pui16Read, &g_pui16Samples[total - count], count * 2) == 0);
+
+    // Every page has been recycled about the same number of times.
+    CHECK(g_ui32SimFlashErases > FLASHLOG_NUM_PAGES);
+
+    reboot();
+    CHECK(logSamples(total, FLASHLOG_BLOCK_SAMPLES));
+    count = readLog(g_pui16Read);
+    total += FLASHLOG_BLOCK_SAMPLES;
+    CHECK(memcmp(g_pui16Read, &g_pui16Samples[total - count], count * 2) == 0);
+}
+
+static void testSequenceWrap(void) {
+    static const uint32_t pui32Sequence[4] = {0xFFFFFFFE, 0xFFFFFFFF, 0, 1};
+    uint8_t pui8Dump[6 + 4 * FLASHLOG_PAGE_SIZE];
+
+    // Pages 5..8 hold sequence numbers either side of the wrap.
+    simFlashReset();
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t address = FLASHLOG_BASE + (5 + i) * FLASHLOG_PAGE_SIZE;
+        simFlashWrite(address, PAGE_MAGIC);
+        simFlashWrite(address + 4, pui32Sequence[i]);
+    }
+    reboot();
+    CHECK(logSamples(0, FLASHLOG_BLOCK_SAMPLES));
+    CHECK((simFlashRead(FLASHLOG_BASE + 8 * FLASHLOG_PAGE_SIZE + 8) &
+           0xFF000000) == RECORD_TAG);
+    CHECK(logMatches(0, FLASHLOG_BLOCK_SAMPLES));
+
+    // The dump sends the pages oldest first.
+    simUartClear();
+    CHECK(flashLogDump(0x4000C000) == 4);
+    CHECK(simUartOutput(pui8Dump, sizeof(pui8Dump)) == sizeof(pui8Dump));
+    CHECK(memcmp(pui8Dump, "FLOG\x04\x00", 6) == 0);
+    for (uint32_t i = 0; i < 4; i++) {
+        const uint8_t *pui8Page = &pui8Dump[6 + i * FLASHLOG_PAGE_SIZE];
+        uint32_t address = FLASHLOG_BASE + (5 + i) * FLASHLOG_PAGE_SIZE;
+
+        for (uint32_t offset = 0; offset < FLASHLOG_PAGE_SIZE; offset++) {
+            if (pui8Page[offset] != (uint8_t)(simFlashRead(address + offset) >>
+                                              (8 * (offset & 3)))) {
+                CHECK(!"dump differs from flash");
+                break;
+            }
+        }
+    }
+}
+
+static void testCorruptRecord(void) {
+    uint32_t page0 = FLASHLOG_BASE;
+
+    // A bad tag behind the last record closes the page.
+    simFlashReset();
+    reboot();
+    CHECK(logSamples(0, 2 * FLASHLOG_BLOCK_SAMPLES));
+    for (uint32_t offset = 8; offset < FLASHLOG_PAGE_SIZE; offset += 4) {
+        if (simFlashRead(page0 + offset) == 0xFFFFFFFF) {
+            simFlashWrite(page0 + offset, 0x12345678);
+            break;
+        }
+    }
+    reboot();
+    CHECK(logSamples(2 * FLASHLOG_BLOCK_SAMPLES, FLASHLOG_BLOCK_SAMPLES));
+    CHECK(simFlashRead(page0 + FLASHLOG_PAGE_SIZE) == PAGE_MAGIC);
+    CHECK(logMatches(0, 3 * FLASHLOG_BLOCK_SAMPLES));
+}
+
+static void testFailures(void) {
+    uint32_t block = FLASHLOG_BLOCK_SAMPLES, count;
+
+    // Failed payload write: that block is lost, logging goes on in the next
+    // page and never writes past the block buffer.
+    simFlashReset();
+    reboot();
+    CHECK(logSamples(0, 3 * block));
+    simFlashFailAfter(0);
+    CHECK(!logSamples(3 * block, block));
+    CHECK(logSamples(4 * block, 3 * block));
+    count = readLog(g_pui16Read);
+    CHECK(count == 6 * block);
+    CHECK(memcmp(g_pui16Read, g_pui16Samples, 3 * block * 2) == 0);
+    CHECK(memcmp(&g_pui16Read[3 * block], &g_pui16Samples[4 * block],
+                 3 * block * 2) == 0);
+
+    // Failed header write: the payload is written but never committed, and
+    // the scan after a reset treats the page as full.
+    simFlashFailAfter(1);
+    CHECK(!logSamples(7 * block, block));
+    reboot();
+    CHECK(logSamples(8 * block, block));
+    count = readLog(g_pui16Read);
+    CHECK(count == 7 * block);
+    CHECK(memcmp(&g_pui16Read[6 * block], &g_pui16Samples[8 * block],
+                 block * 2) == 0);
+
+    // Every write failing: each block is dropped on its own, including the
+    // erase or stamp of every page opened on the way.
+    for (uint32_t i = 0; i < 6; i++) {
+        simFlashFailAfter(i % 3);
+        logSamples(9 * block + i * block, block);
+    }
+    CHECK(logSamples(15 * block, block));
+    count = readLog(g_pui16Read);
+    CHECK(memcmp(&g_pui16Read[count - block], &g_pui16Samples[15 * block],
+                 block * 2) == 0);
+}
+
+// Cuts the power at every word of the writes around two page changes and
+// checks the log recovers with nothing but the torn block missing.
+static void testPowerLoss(void) {
+    uint32_t block = FLASHLOG_BLOCK_SAMPLES;
+
+    for (uint32_t blocks = 8; blocks < 30; blocks++) {
+        for (volatile int32_t words = 0; words < 40; words++) {
+            volatile uint32_t next = blocks * block;
+            uint32_t count;
+
+            simFlashReset();
+            reboot();
+            logSamples(0, blocks * block);
+
+            if (setjmp(g_sSimPowerLoss) == 0) {
+                simFlashTearAfter(words);
+                while (next < (blocks + 2) * block) {
+                    flashLogSample(g_pui16Samples[next]);
+                    next++;
+                }
+            }
+            simFlashTearAfter(-1);
+
+            // Committed blocks are intact; at most the torn one is missing.
+            reboot();
+            count = readLog(g_pui16Read);
+            CHECK(count % block == 0);
+            CHECK(count >= blocks * block && count <= next);
+            CHECK(memcmp(g_pui16Read, g_pui16Samples, count * 2) == 0);
+
+            // Logging resumes and the new blocks read back after the old.
+            CHECK(logSamples(count, 2 * block));
+            reboot();
+            CHECK(logMatches(0, count + 2 * block));
+        }
+    }
+}
+
+int main(void) {
+    makeSamples();
+    testFreshAndResume();
+    testWrapAround();
+    testSequenceWrap();
+    testCorruptRecord();
+    testFailures();
+    testPowerLoss();
+    return CHECK_DONE();
+}
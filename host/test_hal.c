@@ -0,0 +1,153 @@
+/* Purpose of the following file is to test that every generated HAL function
+ * does what the driverlib call it replaces does, against the register models,
+ * and that the cycle counter runs once enabled.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/uart.h"
+#include "hal.h"
+#include "sim.h"
+#include "check.h"
+
+#define STEPS                   4
+
+// Channel in the top bits, time of the conversion below.
+static uint32_t timeSource(uint32_t ui32Base, uint32_t ui32Channel,
+                           uint64_t ui64Time) {
+    return (ui32Channel << 8) | ((ui64Time / SIM_ADC_TICKS) & 0xFF);
+}
+
+static void configureSequence(uint32_t ui32Base) {
+    for (uint32_t step = 0; step < STEPS; step++) {
+        ADCSequenceStepConfigure(ui32Base, 0, step, step |
+                                 (step == STEPS - 1 ? ADC_CTL_IE |
+                                                      ADC_CTL_END : 0));
+    }
+    ADCSequenceEnable(ui32Base, 0);
+}
+
+// The same read through both paths, from the same starting state, returns
+// the same samples taken at the same times.
+static void testAdcRead(void) {
+    uint32_t pui32Hal[HAL_ADC_FIFO_DEPTH], pui32Lib[HAL_ADC_FIFO_DEPTH];
+    uint32_t halCount, libCount;
+
+    simReset();
+    simAdcReset(timeSource);
+    configureSequence(ADC0_BASE);
+    CHECK(!halAdc0Seq0IntStatus());
+    ADCProcessorTrigger(ADC0_BASE, 0);
+    CHECK(halAdc0Seq0IntStatus());
+    ADCIntClear(ADC0_BASE, 0);
+    libCount = ADCSequenceDataGet(ADC0_BASE, 0, pui32Lib);
+
+    simReset();
+    simAdcReset(timeSource);
+    configureSequence(ADC0_BASE);
+    CHECK(!ADCIntStatus(ADC0_BASE, 0, false));
+    halAdc0Seq0Trigger();
+    CHECK(ADCIntStatus(ADC0_BASE, 0, false));
+    halAdc0Seq0IntClear();
+    CHECK(!ADCIntStatus(ADC0_BASE, 0, false));
+    halCount = halAdc0Seq0DataGet(pui32Hal);
+
+    CHECK(libCount == STEPS && halCount == STEPS);
+    CHECK(memcmp(pui32Hal, pui32Lib, sizeof(uint32_t) * STEPS) == 0);
+
+    // The FIFO is empty after the read.
+    CHECK(halAdc0Seq0DataGet(pui32Hal) == 0);
+}
+
+// TriggerWait arms ADC0 without converting; TriggerSignal on ADC1 starts
+// both at the same time. A plain Trigger afterwards clears SYNCWAIT.
+static void testAdcSync(void) {
+    uint32_t pui32Adc0[HAL_ADC_FIFO_DEPTH], pui32Adc1[HAL_ADC_FIFO_DEPTH];
+
+    simReset();
+    simAdcReset(timeSource);
+    configureSequence(ADC0_BASE);
+    configureSequence(ADC1_BASE);
+
+    halAdc0Seq0TriggerWait();
+    simSync();
+    CHECK(g_ui32SimAdcConversions == 0);
+    CHECK(HWREG(ADC0_BASE + ADC_O_PSSI) & ADC_PSSI_SYNCWAIT);
+    halAdc1Seq0TriggerSignal();
+    simSync();
+    CHECK(g_ui32SimAdcConversions == 2 * STEPS);
+    CHECK(halAdc0Seq0IntStatus() && halAdc1Seq0IntStatus());
+    CHECK(halAdc0Seq0DataGet(pui32Adc0) == STEPS);
+    CHECK(halAdc1Seq0DataGet(pui32Adc1) == STEPS);
+    CHECK(memcmp(pui32Adc0, pui32Adc1, sizeof(uint32_t) * STEPS) == 0);
+
+    halAdc0Seq0IntClear();
+    halAdc0Seq0Trigger();
+    simSync();
+    CHECK(g_ui32SimAdcConversions == 3 * STEPS);
+    CHECK(!(HWREG(ADC0_BASE + ADC_O_PSSI) & ADC_PSSI_SYNCWAIT));
+}
+
+static void testUart(void) {
+    static const uint8_t pui8Text[] = { 'h', 'a', 'l', 0x00, 0xFF, '\n' };
+    uint8_t pui8Out[2 * sizeof(pui8Text)];
+
+    simReset();
+    for (uint32_t i = 0; i < sizeof(pui8Text); i++) {
+        halUart0CharPut(pui8Text[i]);
+    }
+    for (uint32_t i = 0; i < sizeof(pui8Text); i++) {
+        UARTCharPut(UART0_BASE, pui8Text[i]);
+    }
+    CHECK(simUartOutput(pui8Out, sizeof(pui8Out)) == sizeof(pui8Out));
+    CHECK(memcmp(pui8Out, pui8Text, sizeof(pui8Text)) == 0);
+    CHECK(memcmp(pui8Out + sizeof(pui8Text), pui8Text,
+                 sizeof(pui8Text)) == 0);
+
+    CHECK(halUart0CharsAvail() == UARTCharsAvail(UART0_BASE));
+    CHECK(halUart0CharGet() == -1);
+}
+
+// The LED write only touches its own pin.
+static void testLed(void) {
+    simReset();
+    simTimerReset();
+
+    GPIOPinWrite(GPIO_PORTG_BASE, GPIO_PIN_0, GPIO_PIN_0);
+    halLedWrite(true);
+    CHECK(simGpioData(GPIO_PORTG_BASE) == (GPIO_PIN_0 | GPIO_PIN_2));
+    halLedWrite(false);
+    CHECK(simGpioData(GPIO_PORTG_BASE) == GPIO_PIN_0);
+    GPIOPinWrite(GPIO_PORTG_BASE, GPIO_PIN_2, GPIO_PIN_2);
+    halLedWrite(false);
+    CHECK(simGpioData(GPIO_PORTG_BASE) == GPIO_PIN_0);
+}
+
+static void testCycleCounter(void) {
+    uint32_t first;
+
+    simReset();
+    CHECK(halCycleCount() == 0);
+
+    halCycleCounterEnable();
+    first = halCycleCount();
+    for (uint32_t spin = 0; spin < 1000 && halCycleCount() == first; spin++) {
+    }
+    CHECK(halCycleCount() != first);
+}
+
+int main(void) {
+    testAdcRead();
+    testAdcSync();
+    testUart();
+    testLed();
+    testCycleCounter();
+    return CHECK_DONE();
+}
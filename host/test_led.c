@@ -0,0 +1,150 @@
+/* Purpose of the following file is to test the status LED patterns against
+ * the timer model: the length of every on and off step, switching between
+ * patterns, and the range checks of ledSetDuty().
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#include "led.h"
+#include "sim.h"
+#include "check.h"
+
+#define LED_PIN                 0x04
+
+static uint32_t g_ui32TicksPerUs;
+
+static void start(void) {
+    simReset();
+    simTimerReset();
+    simTimerSetHandler(TIMER2_BASE, LEDTimerIntHandler);
+    ledInit();
+    g_ui32TicksPerUs = SysCtlClockGet() / 1000000;
+}
+
+static bool ledOn(void) {
+    return (simGpioData(GPIO_PORTG_BASE) & LED_PIN) != 0;
+}
+
+// Checks that the LED, switched on at ui64Start, then follows the steps (in
+// us) for ui32Repeats rounds of the pattern.
+static bool followsSteps(uint64_t ui64Start, const uint32_t *pui32Steps,
+                         uint32_t ui32NumSteps, uint32_t ui32Repeats) {
+    uint64_t expected = ui64Start;
+    uint32_t edge = 0;
+
+    while (edge < g_ui32SimGpioEdges &&
+           g_psSimGpioTrace[edge].ui64Time <= ui64Start) {
+        edge++;
+    }
+    for (uint32_t i = 0; i < ui32NumSteps * ui32Repeats; i++, edge++) {
+        expected += (uint64_t)pui32Steps[i % ui32NumSteps] * g_ui32TicksPerUs;
+        if (edge >= g_ui32SimGpioEdges ||
+            g_psSimGpioTrace[edge].ui64Time != expected ||
+            !(g_psSimGpioTrace[edge].ui8Data & LED_PIN) != !(i & 1)) {
+            printf("step %u does not end at tick %llu\n", i,
+                   (unsigned long long)expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Switches pattern and returns the time it started, checking the LED came on.
+static uint64_t setPattern(tLedPattern ePattern) {
+    ledSetPattern(ePattern);
+    CHECK(ledOn());
+    return g_ui64SimTicks;
+}
+
+static void testBuiltIn(void) {
+    static const uint32_t pui32Acquiring[] = { 12500, 237500 };
+    static const uint32_t pui32Heartbeat[] = { 80000, 120000, 80000, 720000 };
+    static const uint32_t pui32Alarm[] = { 100000, 100000 };
+    uint64_t started;
+
+    start();
+    CHECK(!ledOn() && !simTimerEnabled(TIMER2_BASE));
+
+    started = setPattern(LED_ACQUIRING);
+    simTimerRun(3 * 250000 * g_ui32TicksPerUs);
+    CHECK(followsSteps(started, pui32Acquiring, 2, 3));
+
+    // Setting the running pattern again does not restart it.
+    started = setPattern(LED_HEARTBEAT);
+    simTimerRun(50000 * g_ui32TicksPerUs);
+    ledSetPattern(LED_HEARTBEAT);
+    simTimerRun(2 * 1000000 * g_ui32TicksPerUs);
+    CHECK(followsSteps(started, pui32Heartbeat, 4, 2));
+
+    // Switching part way through a step starts the new pattern from its
+    // first step.
+    simTimerRun(30000 * g_ui32TicksPerUs);
+    started = setPattern(LED_ALARM);
+    simTimerRun(2 * 200000 * g_ui32TicksPerUs);
+    CHECK(followsSteps(started, pui32Alarm, 2, 2));
+
+    ledSetPattern(LED_ON);
+    CHECK(ledOn() && !simTimerEnabled(TIMER2_BASE));
+    ledSetPattern(LED_OFF);
+    CHECK(!ledOn() && !simTimerEnabled(TIMER2_BASE));
+    {
+        uint32_t edges = g_ui32SimGpioEdges;
+        simTimerRun(10000000);
+        CHECK(g_ui32SimGpioEdges == edges);
+    }
+}
+
+static void testDuty(void) {
+    uint32_t pui32Steps[2];
+    uint64_t started;
+
+    start();
+
+    // Out of range: rejected, nothing changes.
+    CHECK(!ledSetDuty(1000000, 101));
+    CHECK(!ledSetDuty(0, 50));
+    CHECK(!ledSetDuty(0xFFFFFFFF / g_ui32TicksPerUs + 1, 50));
+    CHECK(!ledSetDuty(0xFFFFFFFF, 100));
+    CHECK(ledSetDuty(0xFFFFFFFF / g_ui32TicksPerUs, 100));
+
+    CHECK(ledSetDuty(1000000, 25));
+    CHECK(!ledSetDuty(1000000, 200));
+    started = setPattern(LED_CUSTOM);
+    simTimerRun(3 * 1000000 * g_ui32TicksPerUs);
+    pui32Steps[0] = 250000;
+    pui32Steps[1] = 750000;
+    CHECK(followsSteps(started, pui32Steps, 2, 3));
+
+    // A new duty cycle takes effect at once, rounded down to whole us.
+    simTimerRun(400000 * g_ui32TicksPerUs);
+    CHECK(!ledOn());
+    CHECK(ledSetDuty(999, 33));
+    CHECK(ledOn());
+    started = g_ui64SimTicks;
+    simTimerRun(4 * 999 * g_ui32TicksPerUs);
+    pui32Steps[0] = 329;
+    pui32Steps[1] = 670;
+    CHECK(followsSteps(started, pui32Steps, 2, 4));
+
+    // 0% and 100% hold the LED without the timer.
+    CHECK(ledSetDuty(1000000, 0));
+    CHECK(!ledOn() && !simTimerEnabled(TIMER2_BASE));
+    CHECK(ledSetDuty(1000000, 100));
+    CHECK(ledOn() && !simTimerEnabled(TIMER2_BASE));
+
+    // Leaving the custom blink and coming back uses the stored duty.
+    ledSetPattern(LED_OFF);
+    CHECK(ledSetDuty(400000, 50));
+    CHECK(!ledOn());
+    ledSetPattern(LED_CUSTOM);
+    CHECK(ledOn() && simTimerEnabled(TIMER2_BASE));
+}
+
+int main(void) {
+    testBuiltIn();
+    testDuty();
+    return CHECK_DONE();
+}
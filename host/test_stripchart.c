@@ -0,0 +1,183 @@
+/* Purpose of the following file is to test what the strip chart draws: the
+ * envelope of each column, the column blanked ahead of the trace, when the
+ * range changes and the chart is redrawn, and that a spike of a single
+ * sample is never lost.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "grlib_stub.h"
+#include "stripchart.h"
+#include "check.h"
+
+static tContext g_sContext;
+
+// First and last yellow row of a column, or false if it has none or the
+// yellow is not one unbroken line.
+static bool traceRows(uint32_t ui32Column, int32_t *pi32Top,
+                      int32_t *pi32Bottom) {
+    int32_t top = -1, bottom = -1;
+
+    for (int32_t y = 0; y < GRSTUB_HEIGHT; y++) {
+        if (g_ppui32Framebuffer[y][ui32Column] == ClrYellow) {
+            if (top < 0) {
+                top = y;
+            } else if (bottom != y - 1) {
+                return false;
+            }
+            bottom = y;
+        }
+    }
+    *pi32Top = top;
+    *pi32Bottom = bottom;
+    return top >= 0;
+}
+
+static bool columnBlank(uint32_t ui32Column) {
+    for (int32_t y = STRIPCHART_TOP; y <= STRIPCHART_BOTTOM; y++) {
+        if (g_ppui32Framebuffer[y][ui32Column] != ClrBlack) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bannerUntouched(void) {
+    for (int32_t y = 0; y < STRIPCHART_TOP; y++) {
+        for (int32_t x = 0; x < GRSTUB_WIDTH; x++) {
+            if (g_ppui32Framebuffer[y][x] != ClrWhite) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void start(void) {
+    // White marks pixels the chart never drew.
+    grStubReset(ClrWhite);
+    stripChartInit(&g_sContext);
+    stripChartRedraw();
+}
+
+static void frame(uint32_t ui32Value, uint32_t ui32Samples) {
+    for (uint32_t i = 0; i < ui32Samples; i++) {
+        stripChartSample(ui32Value);
+    }
+    stripChartDraw();
+}
+
+static void testFlatColumn(void) {
+    int32_t top, bottom;
+
+    start();
+    CHECK(g_ui32GrRectFills == 1);
+
+    // Nothing received: nothing drawn.
+    grStubClearCounts();
+    stripChartDraw();
+    CHECK(g_ui32GrPixels == 0);
+
+    // A flat 2000 gets the minimum span of 64 counts centred on it,
+    // 1968..2032, which puts it 25 rows above the bottom.
+    frame(2000, 10);
+    CHECK(traceRows(0, &top, &bottom));
+    CHECK(top == STRIPCHART_BOTTOM - 25 && bottom == top);
+    CHECK(columnBlank(1));
+    CHECK(bannerUntouched());
+
+    for (uint32_t column = 1; column < 40; column++) {
+        frame(2000, 10);
+        CHECK(traceRows(column, &top, &bottom));
+        CHECK(top == STRIPCHART_BOTTOM - 25 && bottom == top);
+        CHECK(columnBlank(column + 1));
+    }
+    CHECK(bannerUntouched());
+}
+
+static void testSpikePreserved(void) {
+    int32_t top, bottom, flatRow;
+
+    start();
+    for (uint32_t column = 0; column < 10; column++) {
+        frame(2000, 300);
+    }
+    CHECK(traceRows(9, &flatRow, &bottom));
+
+    // One sample in 500 goes high, one goes low, in different frames.
+    for (uint32_t i = 0; i < 500; i++) {
+        stripChartSample(i == 250 ? 2020 : 2000);
+    }
+    stripChartDraw();
+    CHECK(traceRows(10, &top, &bottom));
+    CHECK(top < flatRow && bottom == flatRow);
+
+    for (uint32_t i = 0; i < 500; i++) {
+        stripChartSample(i == 499 ? 1980 : 2000);
+    }
+    stripChartDraw();
+    CHECK(traceRows(11, &top, &bottom));
+    CHECK(top == flatRow && bottom > flatRow);
+}
+
+static void testAutoRange(void) {
+    int32_t top, bottom;
+    uint32_t fills;
+
+    start();
+    for (uint32_t column = 0; column < 20; column++) {
+        frame(2000, 5);
+    }
+
+    // Leaving the range redraws the whole chart with a wider range: the
+    // earlier columns move, and the spike fits on screen.
+    grStubClearCounts();
+    frame(3000, 1);
+    CHECK(g_ui32GrRectFills == 1);
+    CHECK(traceRows(20, &top, &bottom));
+    CHECK(top > STRIPCHART_TOP && top < STRIPCHART_TOP + 8);
+    CHECK(traceRows(5, &top, &bottom));
+    CHECK(top > STRIPCHART_BOTTOM - 8 && top < STRIPCHART_BOTTOM);
+
+    // Inside the range only the new column is drawn.
+    grStubClearCounts();
+    frame(2500, 5);
+    CHECK(g_ui32GrRectFills == 0);
+
+    // The range only shrinks at the end of a sweep, once the spike has
+    // scrolled off.
+    for (uint32_t column = 22; column < STRIPCHART_WIDTH; column++) {
+        frame(2000, 5);
+    }
+    fills = g_ui32GrRectFills;
+    for (uint32_t column = 0; column < STRIPCHART_WIDTH; column++) {
+        frame(2000, 5);
+    }
+    CHECK(g_ui32GrRectFills == fills + 1);
+    CHECK(traceRows(50, &top, &bottom));
+    CHECK(top == STRIPCHART_BOTTOM - 25);
+    CHECK(bannerUntouched());
+}
+
+// An incremental frame touches two columns of the chart; a redraw touches
+// all of it.
+static void testFrameCost(void) {
+    start();
+    frame(2000, 5);
+    for (uint32_t column = 1; column < 60; column++) {
+        grStubClearCounts();
+        frame(1990 + column % 20, 5);
+        CHECK(g_ui32GrRectFills == 0);
+        CHECK(g_ui32GrPixels <= 3 * (STRIPCHART_BOTTOM - STRIPCHART_TOP + 1));
+    }
+}
+
+int main(void) {
+    testFlatColumn();
+    testSpikePreserved();
+    testAutoRange();
+    testFrameCost();
+    return CHECK_DONE();
+}
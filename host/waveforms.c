@@ -0,0 +1,62 @@
+/* Purpose of the following file is to generate the synthetic 12-bit signals
+ * shared by the host tests and benchmarks. The signals are deterministic so
+ * results can be compared between runs.
+ *
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "waveforms.h"
+
+#define PI 3.14159265358979323846
+
+static const char *g_ppcNames[WAVE_NUM] = {
+    "constant", "ramp", "sine", "noisy sine", "square", "noise", "full scale"
+};
+
+const char *waveName(tWaveform eWave) {
+    return g_ppcNames[eWave];
+}
+
+void waveGenerate(tWaveform eWave, uint16_t *pui16Out, uint32_t ui32Count) {
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < ui32Count; i++) {
+        double value = 2048;
+
+        seed = seed * 1103515245 + 12345;
+        switch (eWave) {
+        case WAVE_CONSTANT:
+            break;
+        case WAVE_RAMP:
+            value = (i * 3) % 4096;
+            break;
+        case WAVE_SINE:
+            // 50 Hz at 10 kHz sampling.
+            value = 2048 + 1500 * sin(2 * PI * 50 * i / 10000.0);
+            break;
+        case WAVE_NOISY_SINE:
+            // Same with a few LSBs of noise, like a real ADC input.
+            value = 2048 + 1500 * sin(2 * PI * 50 * i / 10000.0) +
+                    (double)((seed >> 16) & 15) - 7.5;
+            break;
+        case WAVE_SQUARE:
+            value = (i / 100) & 1 ? 3500 : 500;
+            break;
+        case WAVE_NOISE:
+            value = (seed >> 16) & 0x0FFF;
+            break;
+        case WAVE_FULL_SCALE:
+            value = i & 1 ? 4095 : 0;
+            break;
+        default:
+            break;
+        }
+        if (value < 0) {
+            value = 0;
+        } else if (value > 4095) {
+            value = 4095;
+        }
+        pui16Out[i] = (uint16_t)(value + 0.5);
+    }
+}
@@ -0,0 +1,26 @@
+/* Purpose of the following file is to generate the synthetic 12-bit signals
+ * shared by the host tests and benchmarks.
+ *
+ */
+
+#ifndef __WAVEFORMS_H__
+#define __WAVEFORMS_H__
+
+#include <stdint.h>
+
+typedef enum {
+    WAVE_CONSTANT,
+    WAVE_RAMP,
+    WAVE_SINE,
+    WAVE_NOISY_SINE,
+    WAVE_SQUARE,
+    WAVE_NOISE,
+    WAVE_FULL_SCALE,
+    WAVE_NUM
+} tWaveform;
+
+extern const char *waveName(tWaveform eWave);
+extern void waveGenerate(tWaveform eWave, uint16_t *pui16Out,
+                         uint32_t ui32Count);
+
+#endif // __WAVEFORMS_H__
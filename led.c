@@ -0,0 +1,152 @@
+/* Purpose of the following file is to blink the status LED without delay
+ * loops.
+ *
+ * A pattern is a list of step lengths in microseconds, alternating LED on and
+ * LED off, that repeats forever. Timer 2A runs one-shot for the length of the
+ * current step; its interrupt switches the LED, loads the next step and
+ * restarts the timer. Nothing runs between transitions.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "hal.h"
+#include "led.h"
+
+#define LED_GPIO_BASE           GPIO_PORTG_BASE
+#define LED_PIN                 GPIO_PIN_2
+
+// Timer 2A counts down from a 32-bit load value.
+#define LED_MAX_TICKS           0xFFFFFFFF
+
+// The 5% blink that used to be done with 200000 / 3800000 cycle delays at
+// 16 MHz.
+static const uint32_t g_pui32Acquiring[] = { 12500, 237500 };
+static const uint32_t g_pui32Heartbeat[] = { 80000, 120000, 80000, 720000 };
+static const uint32_t g_pui32Alarm[] = { 100000, 100000 };
+static uint32_t g_pui32Custom[2];
+
+static const uint32_t *g_pui32Steps;
+static uint32_t g_ui32NumSteps;
+static volatile uint32_t g_ui32Step;
+static uint32_t g_ui32TicksPerUs;
+static tLedPattern g_eCurrent = LED_OFF;
+
+// Stops the pattern engine and leaves the LED in a fixed state.
+static void stopPattern(bool bOn) {
+    TimerDisable(TIMER2_BASE, TIMER_A);
+    TimerIntClear(TIMER2_BASE, TIMER_TIMA_TIMEOUT);
+    IntPendClear(INT_TIMER2A);
+    GPIOPinWrite(LED_GPIO_BASE, LED_PIN, bOn ? LED_PIN : 0);
+}
+
+static void startPattern(const uint32_t *pui32Steps, uint32_t ui32NumSteps) {
+    stopPattern(true);
+    g_pui32Steps = pui32Steps;
+    g_ui32NumSteps = ui32NumSteps;
+    g_ui32Step = 0;
+    TimerLoadSet(TIMER2_BASE, TIMER_A, pui32Steps[0] * g_ui32TicksPerUs);
+    TimerEnable(TIMER2_BASE, TIMER_A);
+}
+
+void ledInit(void) {
+    // Enable the GPIO port that is used for the on-board LED.
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOG);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER2);
+
+    // Check if the peripheral access is enabled.
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOG) ||
+          !SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER2))
+    {
+    }
+
+    GPIOPinTypeGPIOOutput(LED_GPIO_BASE, LED_PIN);
+
+    g_ui32TicksPerUs = SysCtlClockGet() / 1000000;
+    TimerConfigure(TIMER2_BASE, TIMER_CFG_ONE_SHOT);
+    TimerIntEnable(TIMER2_BASE, TIMER_TIMA_TIMEOUT);
+    IntEnable(INT_TIMER2A);
+
+    g_eCurrent = LED_OFF;
+    stopPattern(false);
+}
+
+// Switches to one of the built-in patterns. Setting the pattern that is
+// already running does nothing, so this can be called every loop pass.
+void ledSetPattern(tLedPattern ePattern) {
+    if (ePattern == g_eCurrent) {
+        return;
+    }
+    g_eCurrent = ePattern;
+
+    switch (ePattern) {
+    case LED_ON:
+        stopPattern(true);
+        break;
+    case LED_HEARTBEAT:
+        startPattern(g_pui32Heartbeat, 4);
+        break;
+    case LED_ACQUIRING:
+        startPattern(g_pui32Acquiring, 2);
+        break;
+    case LED_ALARM:
+        startPattern(g_pui32Alarm, 2);
+        break;
+    case LED_CUSTOM:
+        // 0% and 100% leave the LED fixed.
+        if (g_pui32Custom[0] == 0 || g_pui32Custom[1] == 0) {
+            stopPattern(g_pui32Custom[0] != 0);
+        } else {
+            startPattern(g_pui32Custom, 2);
+        }
+        break;
+    default:
+        stopPattern(false);
+        break;
+    }
+}
+
+// Sets the blink shown by LED_CUSTOM, restarting it if it is running.
+// Returns false and keeps the old blink if the duty cycle is over 100% or
+// the period does not fit the timer.
+bool ledSetDuty(uint32_t ui32PeriodUs, uint32_t ui32DutyPercent) {
+    uint32_t ui32TicksPerUs = SysCtlClockGet() / 1000000;
+
+    if (ui32DutyPercent > 100 || ui32PeriodUs == 0 ||
+        ui32PeriodUs > LED_MAX_TICKS / ui32TicksPerUs) {
+        return false;
+    }
+
+    g_pui32Custom[0] = (uint32_t)((uint64_t)ui32PeriodUs * ui32DutyPercent /
+                                  100);
+    g_pui32Custom[1] = ui32PeriodUs - g_pui32Custom[0];
+
+    if (g_eCurrent == LED_CUSTOM) {
+        g_eCurrent = LED_OFF;
+        ledSetPattern(LED_CUSTOM);
+    }
+    return true;
+}
+
+// Timer 2A timeout: move to the next step. Even steps are on, odd steps off.
+void LEDTimerIntHandler(void) {
+    uint32_t step;
+
+    TimerIntClear(TIMER2_BASE, TIMER_TIMA_TIMEOUT);
+
+    step = g_ui32Step + 1;
+    if (step >= g_ui32NumSteps) {
+        step = 0;
+    }
+    g_ui32Step = step;
+
+    halLedWrite(!(step & 1));
+    TimerLoadSet(TIMER2_BASE, TIMER_A, g_pui32Steps[step] * g_ui32TicksPerUs);
+    TimerEnable(TIMER2_BASE, TIMER_A);
+}
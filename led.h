@@ -0,0 +1,36 @@
+/* Purpose of the following file is to declare the status LED driver. The LED
+ * on PG2 is switched by a timer interrupt, so blink patterns cost no CPU time
+ * between transitions.
+ *
+ */
+
+#ifndef __LED_H__
+#define __LED_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    LED_OFF,
+    LED_ON,
+    LED_HEARTBEAT,      // Double blink once a second, board is idle
+    LED_ACQUIRING,      // Short 5% duty blink while samples are sent or logged
+    LED_ALARM,          // Fast even blink after a logging failure
+    LED_CUSTOM          // Set by ledSetDuty()
+} tLedPattern;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void ledInit(void);
+extern void ledSetPattern(tLedPattern ePattern);
+extern bool ledSetDuty(uint32_t ui32PeriodUs, uint32_t ui32DutyPercent);
+extern void LEDTimerIntHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LED_H__
@@ -0,0 +1,163 @@
+/* Purpose of the following file is to draw the selected channel as a
+ * waveform on the OLED without redrawing the whole screen every frame.
+ *
+ * Samples arrive much faster than the display refreshes, so each frame
+ * reduces everything received since the last one to a min/max envelope and
+ * draws it as a single vertical line. Spikes therefore always show up, even
+ * when hundreds of samples fall on one column.
+ *
+ * The chart sweeps from left to right like an oscilloscope: a frame draws
+ * only the newest column and blanks the one after it, which marks where the
+ * trace will continue. The whole chart is only redrawn when the vertical
+ * range has to change.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "stripchart.h"
+
+#define STRIPCHART_HEIGHT       (STRIPCHART_BOTTOM - STRIPCHART_TOP + 1)
+
+// Smallest vertical span in ADC counts, so noise on a flat signal is not
+// stretched over the full chart height.
+#define STRIPCHART_MIN_SPAN     64
+#define STRIPCHART_ADC_MAX      4095
+
+static tContext *g_psContext;
+
+// Envelope of every column on screen, and how many have been drawn.
+static uint16_t g_pui16ColumnMin[STRIPCHART_WIDTH];
+static uint16_t g_pui16ColumnMax[STRIPCHART_WIDTH];
+static uint32_t g_ui32Columns;
+static uint32_t g_ui32Head;
+
+// Envelope of the samples received since the last frame.
+static uint32_t g_ui32PendingMin;
+static uint32_t g_ui32PendingMax;
+static bool g_bPending;
+
+// Current vertical range in ADC counts.
+static uint32_t g_ui32Low;
+static uint32_t g_ui32High;
+
+static tRectangle g_sChartRect;
+
+static int32_t toRow(uint32_t ui32Value) {
+    return STRIPCHART_BOTTOM - (int32_t)((ui32Value - g_ui32Low) *
+                                         (STRIPCHART_HEIGHT - 1) /
+                                         (g_ui32High - g_ui32Low));
+}
+
+static void drawColumn(uint32_t ui32Column) {
+    GrContextForegroundSet(g_psContext, ClrBlack);
+    GrLineDrawV(g_psContext, ui32Column, STRIPCHART_TOP, STRIPCHART_BOTTOM);
+    GrContextForegroundSet(g_psContext, ClrYellow);
+    GrLineDrawV(g_psContext, ui32Column, toRow(g_pui16ColumnMax[ui32Column]),
+                toRow(g_pui16ColumnMin[ui32Column]));
+}
+
+// Fits the range to the columns on screen with a small margin. Returns true
+// if it changed.
+static bool fitRange(void) {
+    uint32_t low = STRIPCHART_ADC_MAX;
+    uint32_t high = 0;
+    uint32_t margin;
+
+    for (uint32_t column = 0; column < g_ui32Columns; column++) {
+        if (g_pui16ColumnMin[column] < low) {
+            low = g_pui16ColumnMin[column];
+        }
+        if (g_pui16ColumnMax[column] > high) {
+            high = g_pui16ColumnMax[column];
+        }
+    }
+
+    margin = (high - low) / 8;
+    if (high - low + 2 * margin < STRIPCHART_MIN_SPAN) {
+        margin = (STRIPCHART_MIN_SPAN - (high - low) + 1) / 2;
+    }
+    low = low > margin ? low - margin : 0;
+    high = high + margin < STRIPCHART_ADC_MAX ? high + margin :
+           STRIPCHART_ADC_MAX;
+
+    if (low == g_ui32Low && high == g_ui32High) {
+        return false;
+    }
+    g_ui32Low = low;
+    g_ui32High = high;
+    return true;
+}
+
+void stripChartInit(tContext *psContext) {
+    g_psContext = psContext;
+    g_ui32Columns = 0;
+    g_ui32Head = 0;
+    g_bPending = false;
+    g_ui32Low = 0;
+    g_ui32High = STRIPCHART_ADC_MAX;
+
+    g_sChartRect.i16XMin = 0;
+    g_sChartRect.i16YMin = STRIPCHART_TOP;
+    g_sChartRect.i16XMax = STRIPCHART_WIDTH - 1;
+    g_sChartRect.i16YMax = STRIPCHART_BOTTOM;
+}
+
+// Folds one sample into the envelope of the next column. Cheap enough to
+// call for every sample.
+void stripChartSample(uint32_t ui32Value) {
+    if (!g_bPending) {
+        g_ui32PendingMin = ui32Value;
+        g_ui32PendingMax = ui32Value;
+        g_bPending = true;
+    } else if (ui32Value < g_ui32PendingMin) {
+        g_ui32PendingMin = ui32Value;
+    } else if (ui32Value > g_ui32PendingMax) {
+        g_ui32PendingMax = ui32Value;
+    }
+}
+
+// Clears the chart area and draws every stored column.
+void stripChartRedraw(void) {
+    GrContextForegroundSet(g_psContext, ClrBlack);
+    GrRectFill(g_psContext, &g_sChartRect);
+    for (uint32_t column = 0; column < g_ui32Columns; column++) {
+        drawColumn(column);
+    }
+}
+
+// Draws one frame: the envelope collected since the last call becomes the
+// newest column. Nothing is drawn if no samples arrived.
+void stripChartDraw(void) {
+    uint32_t column = g_ui32Head;
+
+    if (!g_bPending) {
+        return;
+    }
+    g_bPending = false;
+
+    g_pui16ColumnMin[column] = g_ui32PendingMin;
+    g_pui16ColumnMax[column] = g_ui32PendingMax;
+    if (g_ui32Columns < STRIPCHART_WIDTH) {
+        g_ui32Columns++;
+    }
+    g_ui32Head = (column + 1) % STRIPCHART_WIDTH;
+
+    // Grow the range as soon as the signal leaves it, but only shrink it
+    // once per sweep so the trace does not jump around.
+    if (g_ui32PendingMin < g_ui32Low || g_ui32PendingMax > g_ui32High ||
+        g_ui32Head == 0 || g_ui32Columns == 1) {
+        if (fitRange()) {
+            stripChartRedraw();
+        } else {
+            drawColumn(column);
+        }
+    } else {
+        drawColumn(column);
+    }
+
+    // Blank the column ahead of the trace.
+    GrContextForegroundSet(g_psContext, ClrBlack);
+    GrLineDrawV(g_psContext, g_ui32Head, STRIPCHART_TOP, STRIPCHART_BOTTOM);
+}
@@ -0,0 +1,32 @@
+/* Purpose of the following file is to declare the scrolling waveform view
+ * drawn on the 96x64 OLED below the banner.
+ *
+ */
+
+#ifndef __STRIPCHART_H__
+#define __STRIPCHART_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+// Chart area, in display pixels. Rows above STRIPCHART_TOP hold the banner.
+#define STRIPCHART_WIDTH        96
+#define STRIPCHART_TOP          12
+#define STRIPCHART_BOTTOM       63
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+extern void stripChartInit(tContext *psContext);
+extern void stripChartSample(uint32_t ui32Value);
+extern void stripChartDraw(void);
+extern void stripChartRedraw(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __STRIPCHART_H__